@@ -0,0 +1,169 @@
+#include "agents.h"
+#include "quaternion.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Agents advanced together before their rotations are looked up in one batch
+#define AGENT_BLOCK 64
+
+// Shared description of one update (workers write disjoint agent ranges)
+typedef struct {
+    AgentSystem* agents;
+    const BSplineCurve* curve;
+    const RMFTable* rmfTable;
+    TrackFrame frame;
+    float dt;
+} AgentJob;
+
+// ============================================================================
+// LIFETIME
+// ============================================================================
+
+AgentSystem* agents_create(int count, int numSegments) {
+    if (count < 1 || numSegments < 1) {
+        fprintf(stderr, "Error: Need at least one agent and one segment\n");
+        return NULL;
+    }
+
+    AgentSystem* agents = (AgentSystem*)calloc(1, sizeof(AgentSystem));
+    if (!agents) return NULL;
+
+    agents->count = count;
+    agents->numSegments = numSegments;
+    agents->segments = (int*)malloc((size_t)count * sizeof(int));
+    agents->ts = (float*)malloc((size_t)count * sizeof(float));
+    agents->speeds = (float*)malloc((size_t)count * sizeof(float));
+    agents->phases = (float*)malloc((size_t)count * sizeof(float));
+    agents->transforms = (float*)malloc((size_t)count * 16 * sizeof(float));
+    if (!agents->segments || !agents->ts || !agents->speeds || !agents->phases ||
+        !agents->transforms) {
+        fprintf(stderr, "Error: Out of memory for %d agents\n", count);
+        agents_free(agents);
+        return NULL;
+    }
+
+    for (int i = 0; i < count; i++) {
+        agents->phases[i] = (float)((double)i * numSegments / count);
+        agents->speeds[i] = 1.0f;
+
+        float* m = agents->transforms + 16 * (size_t)i;
+        for (int k = 0; k < 16; k++) m[k] = (k % 5 == 0) ? 1.0f : 0.0f;
+    }
+    agents_reset(agents);
+    return agents;
+}
+
+void agents_free(AgentSystem* agents) {
+    if (agents) {
+        free(agents->segments);
+        free(agents->ts);
+        free(agents->speeds);
+        free(agents->phases);
+        free(agents->transforms);
+        free(agents);
+    }
+}
+
+void agents_setSpeeds(AgentSystem* agents, float baseSpeed, float spread, unsigned int seed) {
+    for (int i = 0; i < agents->count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        float u = ((seed >> 16) & 0x7fff) / 16383.5f - 1.0f;
+        float speed = baseSpeed * (1.0f + spread * u);
+        agents->speeds[i] = (speed > 0.0f) ? speed : 0.0f;
+    }
+}
+
+void agents_reset(AgentSystem* agents) {
+    for (int i = 0; i < agents->count; i++) {
+        int whole = (int)agents->phases[i];
+        agents->segments[i] = whole % agents->numSegments + 1;
+        agents->ts[i] = agents->phases[i] - (float)whole;
+    }
+}
+
+// ============================================================================
+// UPDATE
+// ============================================================================
+
+/**
+ * Worker w updates the contiguous agent range [w * N / W, (w + 1) * N / W)
+ *
+ * Advance, evaluate and write the matrix in one pass over blocks of
+ * AGENT_BLOCK agents, so each agent's state is loaded once per update.
+ * RMF rotations for a whole block come from one batched key lookup.
+ */
+static void updateTask(void* context, int worker, int numWorkers) {
+    const AgentJob* job = (const AgentJob*)context;
+    AgentSystem* agents = job->agents;
+    const Vec3 startOrientation = {0.0, 0.0, 1.0};
+
+    int first = (int)((long)agents->count * worker / numWorkers);
+    int last = (int)((long)agents->count * (worker + 1) / numWorkers);
+    int numSegments = agents->numSegments;
+
+    double keyPositions[AGENT_BLOCK];
+    Quat rotations[AGENT_BLOCK];
+
+    for (int block = first; block < last; block += AGENT_BLOCK) {
+        int count = (last - block < AGENT_BLOCK) ? last - block : AGENT_BLOCK;
+
+        // Advance; fast agents may cross several segments per step
+        for (int i = block; i < block + count; i++) {
+            float advance = agents->ts[i] + agents->speeds[i] * job->dt;
+            int whole = (int)advance;
+            int segment = agents->segments[i] - 1 + whole;
+            if (segment >= numSegments) segment %= numSegments;
+
+            agents->segments[i] = segment + 1;
+            agents->ts[i] = advance - (float)whole;
+        }
+
+        if (job->frame == TRACK_FRAME_RMF) {
+            bspline_sampleRMFRotations(job->rmfTable, agents->segments + block, agents->ts + block, count,
+                                       keyPositions, rotations);
+        }
+
+        // Same orientation as the single object in the viewer
+        for (int i = block; i < block + count; i++) {
+            float* m = agents->transforms + 16 * (size_t)i;
+            Vec3 position;
+
+            if (job->frame == TRACK_FRAME_RMF) {
+                position = bspline_curvePosition(job->curve, agents->segments[i], agents->ts[i]);
+                quat_toMatrix(rotations[i - block], m);
+            } else if (job->frame == TRACK_FRAME_AXIS) {
+                CurveJet jet = bspline_curveJet(job->curve, agents->segments[i], agents->ts[i], NULL);
+                position = jet.position;
+                quat_toMatrix(quat_fromTwoVectors(startOrientation, jet.tangent), m);
+            } else {
+                FrenetFrame frenet;
+                CurveJet jet = bspline_curveJet(job->curve, agents->segments[i], agents->ts[i], &frenet);
+                position = jet.position;
+                bspline_frenetToMatrix(frenet, m, 1);
+            }
+
+            m[12] = (float)position.x;
+            m[13] = (float)position.y;
+            m[14] = (float)position.z;
+        }
+    }
+}
+
+int agents_update(AgentSystem* agents, const BSplineCurve* curve, const RMFTable* rmfTable,
+                  TrackFrame frame, double dt, ThreadPool* pool) {
+    if (!curve || curve->numSegments != agents->numSegments ||
+        (frame == TRACK_FRAME_RMF && (!rmfTable || rmfTable->numSegments != agents->numSegments))) {
+        fprintf(stderr, "Error: Curve does not match the %d-segment agent path\n",
+                agents->numSegments);
+        return 0;
+    }
+
+    AgentJob job = {agents, curve, rmfTable, frame, (float)(dt > 0.0 ? dt : 0.0)};
+
+    if (pool) {
+        threadpool_run(pool, updateTask, &job);
+    } else {
+        updateTask(&job, 0, 1);
+    }
+    return 1;
+}
@@ -0,0 +1,92 @@
+#ifndef AGENTS_H
+#define AGENTS_H
+
+#include "bspline.h"
+#include "bspline_curve.h"
+#include "bspline_rmf.h"
+#include "track_file.h"
+#include "thread_pool.h"
+
+// ============================================================================
+// MANY-AGENT PATH FOLLOWING
+// Thousands of objects on one curve, each with its own start offset and
+// speed. State is stored as structure-of-arrays, so an update streams
+// through a few dense arrays. agents_update advances every agent and writes
+// its model matrix in the same pass.
+// ============================================================================
+
+/**
+ * Agent state (structure-of-arrays, count entries each)
+ */
+typedef struct {
+    int count;
+    int numSegments;     // Segments of the curve the agents follow
+    int* segments;       // Current segment (1 to numSegments)
+    float* ts;           // Parameter within the segment [0, 1)
+    float* speeds;       // Segments per second
+    float* phases;       // Start position in segments [0, numSegments), see agents_reset
+    float* transforms;   // 16 floats per agent: column-major model matrix (agents_update)
+} AgentSystem;
+
+/**
+ * Create agents spread evenly along the path
+ *
+ * Agent i starts i * numSegments / count segments from the curve start and
+ * moves at 1 segment per second. Transforms are identity until the first
+ * agents_update.
+ *
+ * @param count Number of agents (>= 1)
+ * @param numSegments Segments of the curve the agents will follow (>= 1)
+ * @return Newly allocated agents (free with agents_free), or NULL on error
+ */
+AgentSystem* agents_create(int count, int numSegments);
+
+/**
+ * Free agents
+ *
+ * @param agents Agents to free (NULL is allowed)
+ */
+void agents_free(AgentSystem* agents);
+
+/**
+ * Give every agent its own speed around a common base
+ *
+ * speeds[i] = baseSpeed * (1 + spread * u), u uniform in [-1, 1] from a
+ * fixed pseudo-random sequence (same seed, same speeds).
+ *
+ * @param agents Agents
+ * @param baseSpeed Mean speed in segments per second
+ * @param spread Relative variation (0 = all equal, 0.5 = +-50%)
+ * @param seed Random seed
+ */
+void agents_setSpeeds(AgentSystem* agents, float baseSpeed, float spread, unsigned int seed);
+
+/**
+ * Move every agent back to its phase
+ *
+ * @param agents Agents
+ */
+void agents_reset(AgentSystem* agents);
+
+/**
+ * Advance all agents by dt and compute their model matrices
+ *
+ * Each matrix is translation to the curve point times the rotation the
+ * viewer applies in the given mode, so glMultMatrixf(transform) replaces
+ * glTranslatef + quat_applyRotation / bspline_applyFrenetFrame. RMF
+ * rotations are nlerped between the table's quaternion keys, one batched
+ * lookup per block of agents. Agents wrap from the curve end to the start.
+ * dt = 0 only recomputes the matrices.
+ *
+ * @param agents Agents
+ * @param curve Compiled curve with agents->numSegments segments
+ * @param rmfTable Rotation-minimizing frames (TRACK_FRAME_RMF only, else NULL)
+ * @param frame Orientation mode
+ * @param dt Seconds to advance (>= 0)
+ * @param pool Thread pool (NULL runs single-threaded)
+ * @return 1 on success, 0 if the curve does not match the agents
+ */
+int agents_update(AgentSystem* agents, const BSplineCurve* curve, const RMFTable* rmfTable,
+                  TrackFrame frame, double dt, ThreadPool* pool);
+
+#endif // AGENTS_H
@@ -0,0 +1,194 @@
+/*
+ * ============================================================================
+ * MANY-AGENT UPDATE - THROUGHPUT BENCHMARK
+ * ============================================================================
+ *
+ * Runs agents_update (advance + model matrix for every agent) on a long
+ * synthetic path for each orientation mode and 1, 2, 4, ... N worker
+ * threads, and reports agents updated per millisecond. RMF agents take
+ * their rotations from the table's quaternion keys (quat_sampleKeys);
+ * they are checked against bspline_sampleRMF frames first. Playing a baked
+ * RMF track for every agent (track_sampleBatch, one lerp + nlerp each) is
+ * timed for comparison.
+ *
+ * Usage: ./bench_agents [numAgents] [numControlPoints] [maxThreads]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "bspline.h"
+#include "bspline_curve.h"
+#include "bspline_rmf.h"
+#include "bspline_arclength.h"
+#include "agents.h"
+#include "track_file.h"
+#include "thread_pool.h"
+#include "bench_common.h"
+
+// Timed runs per configuration (best one is reported)
+#define BENCH_REPETITIONS 5
+#define UPDATES_PER_RUN 10
+
+// One simulation step of the viewer, and its default speed (0.01 t per 1/60 s)
+#define TIMESTEP (1.0 / 120.0)
+#define BASE_SPEED 0.6f
+#define SPEED_SPREAD 0.3f
+
+// RMF keys per segment: 16 bytes each, so 128 MB for a million control points
+#define RMF_SAMPLES_PER_SEGMENT 8
+#define ARC_SUBDIVISIONS 16
+
+// Track playback: bake at the viewer's sample rate and a speed of 1 unit/s,
+// faster on long paths so the track stays within TRACK_MAX_SAMPLES
+#define TRACK_TIMESTEP (1.0 / 60.0)
+#define TRACK_SPEED 1.0
+#define TRACK_MAX_SAMPLES (1 << 20)
+
+// Allowed difference between a key-blended RMF matrix entry and bspline_sampleRMF
+#define RMF_KEY_TOLERANCE 1e-3
+
+/**
+ * Best time of one agents_update call
+ */
+static double updateBest(AgentSystem* agents, const BSplineCurve* curve, const RMFTable* rmfTable,
+                         TrackFrame frame, ThreadPool* pool) {
+    double best = 1e30;
+    for (int rep = 0; rep < BENCH_REPETITIONS; rep++) {
+        double start = bench_nowSeconds();
+        for (int u = 0; u < UPDATES_PER_RUN; u++) {
+            agents_update(agents, curve, rmfTable, frame, TIMESTEP, pool);
+        }
+        double elapsed = (bench_nowSeconds() - start) / UPDATES_PER_RUN;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+/**
+ * Largest matrix difference between RMF agents and bspline_sampleRMF frames
+ */
+static double rmfKeyError(AgentSystem* agents, const BSplineCurve* curve, const RMFTable* rmfTable) {
+    agents_reset(agents);
+    agents_update(agents, curve, rmfTable, TRACK_FRAME_RMF, 0.0, NULL);
+
+    double worst = 0.0;
+    for (int i = 0; i < agents->count; i++) {
+        float expected[16];
+        bspline_frenetToMatrix(bspline_sampleRMF(rmfTable, agents->segments[i], agents->ts[i]), expected, 1);
+        const float* m = agents->transforms + 16 * (size_t)i;
+        for (int k = 0; k < 12; k++) {
+            double error = fabs(m[k] - expected[k]);
+            if (error > worst) worst = error;
+        }
+    }
+    return worst;
+}
+
+/**
+ * Best time of one track_sampleBatch call for every agent
+ */
+static double trackBest(const Track* track, double* times, int count, TrackSample* out) {
+    double best = 1e30;
+    for (int rep = 0; rep < BENCH_REPETITIONS; rep++) {
+        double start = bench_nowSeconds();
+        for (int u = 0; u < UPDATES_PER_RUN; u++) {
+            for (int i = 0; i < count; i++) times[i] += TIMESTEP;
+            track_sampleBatch(track, times, count, 1, out);
+        }
+        double elapsed = (bench_nowSeconds() - start) / UPDATES_PER_RUN;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    int numAgents = (argc > 1) ? atoi(argv[1]) : 100000;
+    int numControlPoints = (argc > 2) ? atoi(argv[2]) : 1000;
+    int maxThreads = (argc > 3) ? atoi(argv[3]) : threadpool_cpuCount();
+    if (maxThreads < 1) maxThreads = 1;
+
+    if (numAgents < 1 || numControlPoints < 4) {
+        fprintf(stderr, "Error: Need at least 1 agent and 4 control points\n");
+        return 1;
+    }
+
+    Vec3* points = bench_createLongPath(numControlPoints);
+    BSplineCurve* curve = points ? bspline_compileCurve(points, numControlPoints) : NULL;
+    RMFTable* rmfTable = curve ? bspline_buildRMFTable(curve, RMF_SAMPLES_PER_SEGMENT) : NULL;
+    AgentSystem* agents = curve ? agents_create(numAgents, curve->numSegments) : NULL;
+    if (!rmfTable || !agents) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+    agents_setSpeeds(agents, BASE_SPEED, SPEED_SPREAD, 12345u);
+
+    static const TrackFrame frames[] = {TRACK_FRAME_AXIS, TRACK_FRAME_FRENET, TRACK_FRAME_RMF};
+    static const char* frameNames[] = {"axis", "frenet", "rmf"};
+
+    double keyError = rmfKeyError(agents, curve, rmfTable);
+
+    printf("=== Many-Agent Update ===\n");
+    printf("Agents:          %d\n", numAgents);
+    printf("Control points:  %d\n", numControlPoints);
+    printf("Timestep:        %.4f s\n", TIMESTEP);
+    printf("CPUs online:     %d\n\n", threadpool_cpuCount());
+    printf("%-8s %8s %12s %14s %9s\n", "frame", "threads", "update [ms]", "agents/ms", "speedup");
+
+    for (int f = 0; f < 3; f++) {
+        double baseline = 0.0;
+
+        // 1, 2, 4, ... and finally maxThreads itself (1 thread runs without a pool)
+        for (int threads = 1; threads <= maxThreads; ) {
+            ThreadPool* pool = (threads > 1) ? threadpool_create(threads) : NULL;
+            if (threads > 1 && !pool) {
+                fprintf(stderr, "Error: Failed to create pool with %d threads\n", threads);
+                break;
+            }
+
+            agents_reset(agents);
+            agents_update(agents, curve, rmfTable, frames[f], TIMESTEP, pool);  // Warm up
+            double best = updateBest(agents, curve, rmfTable, frames[f], pool);
+            if (threads == 1) baseline = best;
+
+            printf("%-8s %8d %12.3f %14.0f %8.2fx\n", frameNames[f], threads, best * 1000.0,
+                   numAgents / (best * 1000.0), baseline / best);
+
+            threadpool_free(pool);
+
+            if (threads == maxThreads) break;
+            threads = (threads * 2 < maxThreads) ? threads * 2 : maxThreads;
+        }
+        printf("\n");
+    }
+
+    // Baked track playback, one sample per agent (single-threaded)
+    ArcLengthTable* arcTable = bspline_buildArcLengthTable(curve, ARC_SUBDIVISIONS);
+    Track* track = NULL;
+    if (arcTable) {
+        double speed = arcTable->totalLength / (TRACK_TIMESTEP * TRACK_MAX_SAMPLES);
+        if (speed < TRACK_SPEED) speed = TRACK_SPEED;
+        track = track_bake(curve, arcTable, rmfTable, TRACK_FRAME_RMF, speed, TRACK_TIMESTEP);
+    }
+    double* times = (double*)malloc((size_t)numAgents * sizeof(double));
+    TrackSample* samples = (TrackSample*)malloc((size_t)numAgents * sizeof(TrackSample));
+    if (track && times && samples) {
+        for (int i = 0; i < numAgents; i++) times[i] = (double)i * track->duration / numAgents;
+        double best = trackBest(track, times, numAgents, samples);
+        printf("%-8s %8d %12.3f %14.0f\n\n", "track", 1, best * 1000.0, numAgents / (best * 1000.0));
+    }
+    free(samples);
+    free(times);
+    track_free(track);
+    bspline_freeArcLengthTable(arcTable);
+
+    printf("RMF key rotations match bspline_sampleRMF: %s (max matrix error %.2e)\n",
+           keyError <= RMF_KEY_TOLERANCE ? "yes" : "NO", keyError);
+
+    agents_free(agents);
+    bspline_freeRMFTable(rmfTable);
+    bspline_freeCurve(curve);
+    free(points);
+    return keyError <= RMF_KEY_TOLERANCE ? 0 : 1;
+}
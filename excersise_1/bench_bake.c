@@ -0,0 +1,99 @@
+/*
+ * ============================================================================
+ * BULK PATH BAKING - THREAD SCALING BENCHMARK
+ * ============================================================================
+ *
+ * Bakes a large synthetic path with bspline_bakePath using 1, 2, 4, ... N
+ * worker threads and reports time, throughput and speedup. Every run is
+ * compared byte-for-byte with the single-threaded result.
+ *
+ * Usage: ./bench_bake [numControlPoints] [samplesPerSegment] [maxThreads]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "bspline.h"
+#include "bspline_bake.h"
+#include "thread_pool.h"
+#include "bench_common.h"
+
+// Timed runs per thread count (best one is reported)
+#define BENCH_REPETITIONS 5
+
+static double bakeBest(const Vec3* points, int count, int samples, ThreadPool* pool,
+                       float* positions, float* tangents) {
+    double best = 1e30;
+    for (int rep = 0; rep < BENCH_REPETITIONS; rep++) {
+        double start = bench_nowSeconds();
+        bspline_bakePath(points, count, samples, pool, positions, tangents);
+        double elapsed = bench_nowSeconds() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    int numControlPoints = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int samplesPerSegment = (argc > 2) ? atoi(argv[2]) : 8;
+    int maxThreads = (argc > 3) ? atoi(argv[3]) : threadpool_cpuCount();
+    if (maxThreads < 1) maxThreads = 1;
+
+    long numVertices = bspline_bakeVertexCount(numControlPoints, samplesPerSegment);
+    if (numVertices == 0) {
+        fprintf(stderr, "Error: Need at least 4 control points and 2 samples per segment\n");
+        return 1;
+    }
+
+    Vec3* points = bench_createLongPath(numControlPoints);
+    size_t bytes = (size_t)numVertices * 3 * sizeof(float);
+    float* reference = (float*)malloc(bytes);
+    float* positions = (float*)malloc(bytes);
+    float* tangents = (float*)malloc(bytes);
+    if (!points || !reference || !positions || !tangents) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+
+    printf("=== Bulk Bake Scaling ===\n");
+    printf("Control points:  %d\n", numControlPoints);
+    printf("Samples/segment: %d\n", samplesPerSegment);
+    printf("Output vertices: %ld (%.1f MB positions + tangents)\n",
+           numVertices, 2.0 * bytes / (1024.0 * 1024.0));
+    printf("CPUs online:     %d\n\n", threadpool_cpuCount());
+    printf("%8s %12s %14s %9s %s\n", "threads", "time [ms]", "Mvertices/s", "speedup", "identical");
+
+    // Single-threaded reference (also warms up pages of every buffer)
+    bspline_bakePath(points, numControlPoints, samplesPerSegment, NULL, reference, tangents);
+
+    double baseline = 0.0;
+    // 1, 2, 4, ... and finally maxThreads itself
+    for (int threads = 1; threads <= maxThreads; ) {
+        ThreadPool* pool = threadpool_create(threads);
+        if (!pool) {
+            fprintf(stderr, "Error: Failed to create pool with %d threads\n", threads);
+            break;
+        }
+
+        memset(positions, 0, bytes);
+        double best = bakeBest(points, numControlPoints, samplesPerSegment, pool, positions, tangents);
+        int identical = memcmp(positions, reference, bytes) == 0;
+        if (threads == 1) baseline = best;
+
+        printf("%8d %12.2f %14.1f %8.2fx %s\n", threads, best * 1000.0,
+               numVertices / best / 1e6, baseline / best, identical ? "yes" : "NO");
+
+        threadpool_free(pool);
+
+        if (threads == maxThreads) break;
+        threads = (threads * 2 < maxThreads) ? threads * 2 : maxThreads;
+    }
+
+    free(points);
+    free(reference);
+    free(positions);
+    free(tangents);
+    return 0;
+}
@@ -0,0 +1,722 @@
+/*
+ * ============================================================================
+ * B-SPLINE MODULE MICROBENCHMARKS
+ * ============================================================================
+ *
+ * Measures every evaluation and orientation entry point of bspline.h
+ * (the glRotatef / glMultMatrixf wrappers excepted - they need a GL
+ * context) on paths of several sizes. Queries are (segment, t) pairs in
+ * random order over the whole path, so large paths also pay for the
+ * cache misses a real lookup would. The storage* benchmarks run the same
+ * queries on both CurveStorage layouts (bspline_storage.h), and
+ * storageSampleSegments sweeps consecutive segments at one t, the access
+ * pattern the SoA layout is built for. evaluatorPosition NURBS runs the
+ * queries through CurveEvaluator on nurbs_createUniformCubic of the same
+ * points; before timing, every query is checked against
+ * bspline_evaluatePosition, and a mismatch fails the run. The quat_*
+ * benchmarks blend rotations of the query tangents in blocks with the
+ * batched quaternion.h entry points, per rotation; they are checked
+ * against quat_nlerp / quat_slerp first.
+ *
+ * Per benchmark and size:
+ *   1. calibrate the iteration count so one repetition takes >= min-time
+ *   2. warm up for warmup ms (caches, branch predictors, CPU clock)
+ *   3. time reps repetitions, each giving ns per evaluation
+ *   4. report median and MAD (median absolute deviation), which unlike
+ *      mean and standard deviation are not thrown off by the occasional
+ *      preempted repetition
+ *
+ * Usage: ./bench_bspline [--json FILE|-] [--reps N] [--warmup MS]
+ *                        [--min-time MS] [--sizes N,N,...] [--filter TEXT]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "bspline.h"
+#include "bspline_storage.h"
+#include "curve_evaluator.h"
+#include "bench_common.h"
+#include "quaternion.h"
+
+// Defaults (overridable from the command line)
+#define DEFAULT_REPETITIONS 15
+#define DEFAULT_WARMUP_MS 20.0
+#define DEFAULT_MIN_TIME_MS 2.0
+
+// Random queries per path (power of two so the index is a mask)
+#define NUM_QUERIES (1 << 16)
+
+// Consecutive segments per bspline_storageSampleSegments call
+#define SEGMENT_BLOCK 256
+
+// Allowed NURBS vs evaluatePosition difference, relative to the coordinate size
+// (evaluatePosition rounds its basis weights to float)
+#define NURBS_TOLERANCE 1e-6
+
+// Allowed batched vs scalar quaternion blend difference per component
+// (the batches normalize with a refined rsqrt estimate)
+#define QUAT_TOLERANCE 1e-5
+
+#define MAX_SIZES 16
+#define MAX_REPETITIONS 1001
+
+static const int defaultSizes[] = {8, 512, 32768, 1048576};
+
+// Keeps results observable so the compiler cannot drop the calls
+static volatile double sink;
+
+/**
+ * Inputs shared by all benchmarks for one path size
+ */
+typedef struct {
+    const Vec3* points;
+    int numPoints;
+    int* segments;          // NUM_QUERIES segment indices (1 to n-3)
+    float* ts;              // NUM_QUERIES parameters in [0, 1]
+    Vec3* tangents;         // Tangent at each query (orientation inputs)
+    Vec3* secondDerivs;     // Second derivative at each query
+    CurveStorage* doubleStorage;  // points in both CurveStorage layouts
+    CurveStorage* floatStorage;
+    float* blockOut;        // 3 * SEGMENT_BLOCK floats of segment sweep output
+    NurbsCurve* nurbs;      // Same points as a uniform cubic NURBS curve
+    CurveEvaluator nurbsEvaluator;
+    Quat* rotations;        // Rotation from +Z to each query tangent (also used as keys)
+    double* keyPositions;   // NUM_QUERIES random positions in [0, NUM_QUERIES - 1]
+    Quat* quatOut;          // SEGMENT_BLOCK rotations of batch output
+} BenchInput;
+
+typedef double (*BenchKernel)(const BenchInput* in, long iterations);
+
+typedef struct {
+    const char* name;
+    BenchKernel kernel;
+} Benchmark;
+
+typedef struct {
+    double median;
+    double mad;
+    double min;
+    long iterations;
+} BenchStats;
+
+// ============================================================================
+// KERNELS
+// Each runs the entry point `iterations` times over the query arrays and
+// returns a checksum of the results.
+// ============================================================================
+
+#define QUERY(i) ((int)((i) & (NUM_QUERIES - 1)))
+
+static double benchPosition(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        int k = QUERY(i);
+        sum += bspline_evaluatePosition(in->points, in->segments[k], in->ts[k]).x;
+    }
+    return sum;
+}
+
+static double benchTangent(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        int k = QUERY(i);
+        sum += bspline_evaluateTangent(in->points, in->segments[k], in->ts[k]).x;
+    }
+    return sum;
+}
+
+static double benchTangentAlt(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        int k = QUERY(i);
+        sum += bspline_evaluateTangent_Alt(in->points, in->segments[k], in->ts[k]).x;
+    }
+    return sum;
+}
+
+static double benchSecondDerivative(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        int k = QUERY(i);
+        sum += bspline_evaluateSecondDerivative(in->points, in->segments[k], in->ts[k]).x;
+    }
+    return sum;
+}
+
+static double benchJet(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        int k = QUERY(i);
+        sum += bspline_evaluateJet(in->points, in->segments[k], in->ts[k], NULL).tangent.x;
+    }
+    return sum;
+}
+
+static double benchJetFrame(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    FrenetFrame frame;
+    for (long i = 0; i < iterations; i++) {
+        int k = QUERY(i);
+        bspline_evaluateJet(in->points, in->segments[k], in->ts[k], &frame);
+        sum += frame.normal.x;
+    }
+    return sum;
+}
+
+static double benchFrenetFrame(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        int k = QUERY(i);
+        sum += bspline_computeFrenetFrame(in->points, in->segments[k], in->ts[k]).normal.x;
+    }
+    return sum;
+}
+
+static double benchFrenetFromDerivatives(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        int k = QUERY(i);
+        sum += bspline_frenetFromDerivatives(in->tangents[k], in->secondDerivs[k]).normal.x;
+    }
+    return sum;
+}
+
+static double benchFrenetToMatrix(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    float matrix[16];
+    FrenetFrame frame = bspline_frenetFromDerivatives(in->tangents[0], in->secondDerivs[0]);
+    for (long i = 0; i < iterations; i++) {
+        frame.tangent = in->tangents[QUERY(i)];
+        bspline_frenetToMatrix(frame, matrix, (int)(i & 1));
+        sum += matrix[0];
+    }
+    return sum;
+}
+
+static double benchEulerAngles(const BenchInput* in, long iterations) {
+    const Vec3 worldUp = {0.0, 1.0, 0.0};
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        sum += bspline_getEulerAngles(in->tangents[QUERY(i)], worldUp).yaw;
+    }
+    return sum;
+}
+
+static double benchOrientationAngle(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        sum += bspline_getOrientationAngle(in->tangents[QUERY(i)]);
+    }
+    return sum;
+}
+
+static double benchAxisAngle(const BenchInput* in, long iterations) {
+    const Vec3 start = {0.0, 0.0, 1.0};
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        sum += bspline_computeAxisAngle(start, in->tangents[QUERY(i)]).angle;
+    }
+    return sum;
+}
+
+static double benchCoefficients(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    float c[4];
+    for (long i = 0; i < iterations; i++) {
+        bspline_computeCoefficients(in->ts[QUERY(i)], c);
+        sum += c[1];
+    }
+    return sum;
+}
+
+static double benchDerivativeCoefficients(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    float c[4];
+    for (long i = 0; i < iterations; i++) {
+        bspline_computeDerivativeCoefficients(in->ts[QUERY(i)], c);
+        sum += c[1];
+    }
+    return sum;
+}
+
+static double benchDerivativeCoefficientsAlt(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    float c[4];
+    for (long i = 0; i < iterations; i++) {
+        bspline_computeDerivativeCoefficients_Alt(in->ts[QUERY(i)], c);
+        sum += c[1];
+    }
+    return sum;
+}
+
+static double storagePosition(const CurveStorage* storage, const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        int k = QUERY(i);
+        sum += bspline_storagePosition(storage, in->segments[k], in->ts[k]).x;
+    }
+    return sum;
+}
+
+/**
+ * One iteration is one segment: sweeps blocks of consecutive segments
+ * starting at random query segments
+ */
+static double storageSampleSegments(const CurveStorage* storage, const BenchInput* in, long iterations) {
+    int numSegments = storage->numSegments;
+    float* outX = in->blockOut;
+    float* outY = outX + SEGMENT_BLOCK;
+    float* outZ = outY + SEGMENT_BLOCK;
+    double sum = 0.0;
+
+    for (long done = 0, q = 0; done < iterations; q++) {
+        int count = numSegments < SEGMENT_BLOCK ? numSegments : SEGMENT_BLOCK;
+        if (iterations - done < count) count = (int)(iterations - done);
+
+        int k = QUERY(q);
+        int first = in->segments[k];
+        if (first + count - 1 > numSegments) first = numSegments - count + 1;
+
+        bspline_storageSampleSegments(storage, first, count, in->ts[k], outX, outY, outZ);
+        sum += outX[count - 1];
+        done += count;
+    }
+    return sum;
+}
+
+static double benchStoragePositionDouble(const BenchInput* in, long iterations) {
+    return storagePosition(in->doubleStorage, in, iterations);
+}
+
+static double benchStoragePositionFloat(const BenchInput* in, long iterations) {
+    return storagePosition(in->floatStorage, in, iterations);
+}
+
+static double benchStorageSegmentsDouble(const BenchInput* in, long iterations) {
+    return storageSampleSegments(in->doubleStorage, in, iterations);
+}
+
+static double benchStorageSegmentsFloat(const BenchInput* in, long iterations) {
+    return storageSampleSegments(in->floatStorage, in, iterations);
+}
+
+static double benchEvaluatorNurbs(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        int k = QUERY(i);
+        sum += curve_position(&in->nurbsEvaluator, in->segments[k], in->ts[k]).x;
+    }
+    return sum;
+}
+
+/**
+ * One iteration is one rotation: blends blocks of query rotations with the
+ * block SEGMENT_BLOCK queries further on (slerp or nlerp)
+ */
+static double quatBlend(const BenchInput* in, long iterations, int useSlerp) {
+    double sum = 0.0;
+    for (long done = 0; done < iterations; done += SEGMENT_BLOCK) {
+        int count = (iterations - done < SEGMENT_BLOCK) ? (int)(iterations - done) : SEGMENT_BLOCK;
+        int k = QUERY(done);
+        const Quat* a = in->rotations + k;
+        const Quat* b = in->rotations + QUERY(done + SEGMENT_BLOCK);
+        if (useSlerp) {
+            quat_slerpBatch(a, b, in->ts + k, count, in->quatOut);
+        } else {
+            quat_nlerpBatch(a, b, in->ts + k, count, in->quatOut);
+        }
+        sum += in->quatOut[count - 1].w;
+    }
+    return sum;
+}
+
+static double benchQuatNlerpBatch(const BenchInput* in, long iterations) {
+    return quatBlend(in, iterations, 0);
+}
+
+static double benchQuatSlerpBatch(const BenchInput* in, long iterations) {
+    return quatBlend(in, iterations, 1);
+}
+
+/**
+ * One iteration is one lookup at a random position in the query rotations
+ */
+static double benchQuatSampleKeys(const BenchInput* in, long iterations) {
+    double sum = 0.0;
+    for (long done = 0; done < iterations; done += SEGMENT_BLOCK) {
+        int count = (iterations - done < SEGMENT_BLOCK) ? (int)(iterations - done) : SEGMENT_BLOCK;
+        quat_sampleKeys(in->rotations, NUM_QUERIES, in->keyPositions + QUERY(done), count, 0, in->quatOut);
+        sum += in->quatOut[count - 1].w;
+    }
+    return sum;
+}
+
+static const Benchmark benchmarks[] = {
+    {"evaluatePosition",                  benchPosition},
+    {"evaluateTangent",                   benchTangent},
+    {"evaluateTangent_Alt",               benchTangentAlt},
+    {"evaluateSecondDerivative",          benchSecondDerivative},
+    {"evaluateJet",                       benchJet},
+    {"evaluateJet+frame",                 benchJetFrame},
+    {"computeFrenetFrame",                benchFrenetFrame},
+    {"frenetFromDerivatives",             benchFrenetFromDerivatives},
+    {"frenetToMatrix",                    benchFrenetToMatrix},
+    {"getEulerAngles",                    benchEulerAngles},
+    {"getOrientationAngle",               benchOrientationAngle},
+    {"computeAxisAngle",                  benchAxisAngle},
+    {"computeCoefficients",               benchCoefficients},
+    {"computeDerivativeCoefficients",     benchDerivativeCoefficients},
+    {"computeDerivativeCoefficients_Alt", benchDerivativeCoefficientsAlt},
+    {"storagePosition DOUBLE",            benchStoragePositionDouble},
+    {"storagePosition FLOAT",             benchStoragePositionFloat},
+    {"storageSampleSegments DOUBLE",      benchStorageSegmentsDouble},
+    {"storageSampleSegments FLOAT",       benchStorageSegmentsFloat},
+    {"evaluatorPosition NURBS",           benchEvaluatorNurbs},
+    {"quat_nlerpBatch",                   benchQuatNlerpBatch},
+    {"quat_slerpBatch",                   benchQuatSlerpBatch},
+    {"quat_sampleKeys",                   benchQuatSampleKeys},
+};
+
+#define NUM_BENCHMARKS ((int)(sizeof(benchmarks) / sizeof(benchmarks[0])))
+
+// ============================================================================
+// INPUTS
+// ============================================================================
+
+/**
+ * Wobbly helix (same shape as bench_bake) plus random queries over it
+ */
+static int createInput(BenchInput* in, int numPoints) {
+    Vec3* points = bench_createLongPath(numPoints);
+    in->segments = (int*)malloc(NUM_QUERIES * sizeof(int));
+    in->ts = (float*)malloc(NUM_QUERIES * sizeof(float));
+    in->tangents = (Vec3*)malloc(NUM_QUERIES * sizeof(Vec3));
+    in->secondDerivs = (Vec3*)malloc(NUM_QUERIES * sizeof(Vec3));
+    in->blockOut = (float*)malloc(3 * SEGMENT_BLOCK * sizeof(float));
+    in->rotations = (Quat*)malloc(NUM_QUERIES * sizeof(Quat));
+    in->keyPositions = (double*)malloc(NUM_QUERIES * sizeof(double));
+    in->quatOut = (Quat*)malloc(SEGMENT_BLOCK * sizeof(Quat));
+    in->points = points;
+    in->numPoints = numPoints;
+    in->doubleStorage = NULL;
+    in->floatStorage = NULL;
+    in->nurbs = NULL;
+    if (!points || !in->segments || !in->ts || !in->tangents || !in->secondDerivs || !in->blockOut ||
+        !in->rotations || !in->keyPositions || !in->quatOut) {
+        return 0;
+    }
+
+    unsigned int seed = 12345u;
+
+    int numSegments = bspline_getNumSegments(numPoints);
+    for (int k = 0; k < NUM_QUERIES; k++) {
+        unsigned int r = (bench_nextRandom(&seed) << 15) | bench_nextRandom(&seed);
+        in->segments[k] = 1 + (int)(r % (unsigned int)numSegments);
+        in->ts[k] = bench_nextRandom(&seed) / 32767.0f;
+        in->tangents[k] = bspline_evaluateTangent(points, in->segments[k], in->ts[k]);
+        in->secondDerivs[k] = bspline_evaluateSecondDerivative(points, in->segments[k], in->ts[k]);
+    }
+
+    const Vec3 startOrientation = {0.0, 0.0, 1.0};
+    for (int k = 0; k < NUM_QUERIES; k++) {
+        unsigned int r = (bench_nextRandom(&seed) << 15) | bench_nextRandom(&seed);
+        in->rotations[k] = quat_fromTwoVectors(startOrientation, in->tangents[k]);
+        in->keyPositions[k] = (r % (unsigned int)(NUM_QUERIES - 1)) + bench_nextRandom(&seed) / 32768.0;
+    }
+
+    in->doubleStorage = bspline_createStorage(points, numPoints, CURVE_PRECISION_DOUBLE);
+    in->floatStorage = bspline_createStorage(points, numPoints, CURVE_PRECISION_FLOAT);
+    in->nurbs = nurbs_createUniformCubic(points, numPoints);
+    in->nurbsEvaluator = curve_fromNurbs(in->nurbs);
+    return in->doubleStorage && in->floatStorage && in->nurbs;
+}
+
+static void freeInput(BenchInput* in) {
+    nurbs_free(in->nurbs);
+    bspline_freeStorage(in->doubleStorage);
+    bspline_freeStorage(in->floatStorage);
+    free(in->blockOut);
+    free((void*)in->points);
+    free(in->segments);
+    free(in->ts);
+    free(in->tangents);
+    free(in->secondDerivs);
+    free(in->rotations);
+    free(in->keyPositions);
+    free(in->quatOut);
+}
+
+/**
+ * Largest difference between the uniform cubic NURBS evaluator and
+ * bspline_evaluatePosition over all queries, relative to the coordinate size
+ */
+static double nurbsError(const BenchInput* in) {
+    double worst = 0.0;
+    for (int k = 0; k < NUM_QUERIES; k++) {
+        Vec3 expected = bspline_evaluatePosition(in->points, in->segments[k], in->ts[k]);
+        Vec3 p = curve_position(&in->nurbsEvaluator, in->segments[k], in->ts[k]);
+        double scale = 1.0 + fabs(expected.x) + fabs(expected.y) + fabs(expected.z);
+        double error = (fabs(p.x - expected.x) + fabs(p.y - expected.y) + fabs(p.z - expected.z)) / scale;
+        if (error > worst) worst = error;
+    }
+    return worst;
+}
+
+/**
+ * Largest component difference between the quat_* batches and
+ * quat_nlerp / quat_slerp over the first SEGMENT_BLOCK query rotations
+ */
+static double quatError(const BenchInput* in) {
+    const Quat* a = in->rotations;
+    const Quat* b = in->rotations + SEGMENT_BLOCK;
+    double worst = 0.0;
+
+    for (int mode = 0; mode < 3; mode++) {
+        if (mode == 0) quat_nlerpBatch(a, b, in->ts, SEGMENT_BLOCK, in->quatOut);
+        if (mode == 1) quat_slerpBatch(a, b, in->ts, SEGMENT_BLOCK, in->quatOut);
+        if (mode == 2) quat_sampleKeys(in->rotations, NUM_QUERIES, in->keyPositions, SEGMENT_BLOCK, 0, in->quatOut);
+
+        for (int i = 0; i < SEGMENT_BLOCK; i++) {
+            Quat expected;
+            if (mode == 2) {
+                int k = (int)in->keyPositions[i];
+                expected = quat_nlerp(in->rotations[k], in->rotations[k + 1], (float)(in->keyPositions[i] - k));
+            } else {
+                expected = (mode == 0) ? quat_nlerp(a[i], b[i], in->ts[i]) : quat_slerp(a[i], b[i], in->ts[i]);
+            }
+            Quat q = in->quatOut[i];
+            double error = fmax(fmax(fabs(q.w - expected.w), fabs(q.x - expected.x)),
+                                fmax(fabs(q.y - expected.y), fabs(q.z - expected.z)));
+            if (error > worst) worst = error;
+        }
+    }
+    return worst;
+}
+
+// ============================================================================
+// HARNESS
+// ============================================================================
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Median of values (sorts them in place)
+ */
+static double median(double* values, int count) {
+    qsort(values, count, sizeof(double), compareDoubles);
+    return (count % 2) ? values[count / 2]
+                       : 0.5 * (values[count / 2 - 1] + values[count / 2]);
+}
+
+static double timeRun(const Benchmark* bench, const BenchInput* in, long iterations) {
+    double start = bench_nowSeconds();
+    sink += bench->kernel(in, iterations);
+    return bench_nowSeconds() - start;
+}
+
+static BenchStats runBenchmark(const Benchmark* bench, const BenchInput* in,
+                               int repetitions, double warmupMs, double minTimeMs) {
+    BenchStats stats;
+
+    // Calibrate: double the iteration count until one repetition is long enough
+    long iterations = 1024;
+    while (timeRun(bench, in, iterations) * 1000.0 < minTimeMs && iterations < (1L << 40)) {
+        iterations *= 2;
+    }
+
+    // Warm up
+    double warmupEnd = bench_nowSeconds() + warmupMs / 1000.0;
+    while (bench_nowSeconds() < warmupEnd) {
+        timeRun(bench, in, iterations);
+    }
+
+    // Measure
+    double samples[MAX_REPETITIONS];
+    double deviations[MAX_REPETITIONS];
+    for (int rep = 0; rep < repetitions; rep++) {
+        samples[rep] = timeRun(bench, in, iterations) * 1e9 / iterations;
+    }
+
+    stats.median = median(samples, repetitions);
+    stats.min = samples[0];  // Sorted by median()
+    for (int rep = 0; rep < repetitions; rep++) {
+        deviations[rep] = fabs(samples[rep] - stats.median);
+    }
+    stats.mad = median(deviations, repetitions);
+    stats.iterations = iterations;
+    return stats;
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+static void writeJsonString(FILE* out, const char* text) {
+    fputc('"', out);
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') fputc('\\', out);
+        fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+static void writeJsonHeader(FILE* out, int repetitions, double warmupMs, double minTimeMs) {
+    fprintf(out, "{\n  \"suite\": \"bspline\",\n  \"compiler\": ");
+#ifdef __VERSION__
+    writeJsonString(out, __VERSION__);
+#else
+    writeJsonString(out, "unknown");
+#endif
+    fprintf(out, ",\n  \"timestamp\": %ld,\n", (long)time(NULL));
+    fprintf(out, "  \"repetitions\": %d,\n  \"warmup_ms\": %g,\n  \"min_time_ms\": %g,\n",
+            repetitions, warmupMs, minTimeMs);
+    fprintf(out, "  \"queries\": %d,\n  \"results\": [", NUM_QUERIES);
+}
+
+static void writeJsonResult(FILE* out, int first, const char* name, int numPoints,
+                            const BenchStats* stats) {
+    fprintf(out, "%s\n    {\"name\": ", first ? "" : ",");
+    writeJsonString(out, name);
+    fprintf(out, ", \"control_points\": %d, \"iterations\": %ld, "
+                 "\"median_ns\": %.4f, \"mad_ns\": %.4f, \"min_ns\": %.4f}",
+            numPoints, stats->iterations, stats->median, stats->mad, stats->min);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static int parseSizes(const char* text, int* sizes) {
+    int count = 0;
+    while (*text && count < MAX_SIZES) {
+        char* end;
+        long value = strtol(text, &end, 10);
+        if (end == text || value < 4 || value > 100000000) return 0;
+        sizes[count++] = (int)value;
+        text = (*end == ',') ? end + 1 : end;
+        if (*end && *end != ',') return 0;
+    }
+    return count;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--json FILE|-] [--reps N] [--warmup MS] [--min-time MS]\n"
+                    "       %*s [--sizes N,N,...] [--filter TEXT]\n",
+            program, (int)strlen(program), "");
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    const char* filter = NULL;
+    int repetitions = DEFAULT_REPETITIONS;
+    double warmupMs = DEFAULT_WARMUP_MS;
+    double minTimeMs = DEFAULT_MIN_TIME_MS;
+    int sizes[MAX_SIZES];
+    int numSizes = (int)(sizeof(defaultSizes) / sizeof(defaultSizes[0]));
+    memcpy(sizes, defaultSizes, sizeof(defaultSizes));
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!value) {
+            usage(argv[0]);
+            return 1;
+        }
+        if (strcmp(argv[i], "--json") == 0) {
+            jsonPath = value;
+        } else if (strcmp(argv[i], "--reps") == 0) {
+            repetitions = atoi(value);
+        } else if (strcmp(argv[i], "--warmup") == 0) {
+            warmupMs = atof(value);
+        } else if (strcmp(argv[i], "--min-time") == 0) {
+            minTimeMs = atof(value);
+        } else if (strcmp(argv[i], "--sizes") == 0) {
+            numSizes = parseSizes(value, sizes);
+        } else if (strcmp(argv[i], "--filter") == 0) {
+            filter = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+
+    if (repetitions < 1 || repetitions > MAX_REPETITIONS || numSizes == 0 ||
+        warmupMs < 0.0 || minTimeMs <= 0.0) {
+        fprintf(stderr, "Error: Invalid benchmark options\n");
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE* json = NULL;
+    if (jsonPath) {
+        json = (strcmp(jsonPath, "-") == 0) ? stdout : fopen(jsonPath, "w");
+        if (!json) {
+            fprintf(stderr, "Error: Cannot open '%s' for writing\n", jsonPath);
+            return 1;
+        }
+        writeJsonHeader(json, repetitions, warmupMs, minTimeMs);
+    }
+
+    // With JSON on stdout the human-readable table goes to stderr
+    FILE* table = (json == stdout) ? stderr : stdout;
+    fprintf(table, "=== B-Spline Microbenchmarks ===\n");
+    fprintf(table, "%d repetitions, %.0f ms warmup, >= %.1f ms per repetition\n\n",
+            repetitions, warmupMs, minTimeMs);
+    fprintf(table, "%-34s %9s %11s %9s %7s %11s\n",
+            "benchmark", "points", "median ns", "MAD ns", "MAD %", "min ns");
+
+    int first = 1;
+    int failed = 0;
+    for (int s = 0; s < numSizes; s++) {
+        BenchInput input;
+        if (!createInput(&input, sizes[s])) {
+            fprintf(stderr, "Error: Out of memory for %d control points\n", sizes[s]);
+            freeInput(&input);
+            continue;
+        }
+
+        double error = nurbsError(&input);
+        if (error > NURBS_TOLERANCE) {
+            fprintf(stderr, "Error: Uniform cubic NURBS differs from evaluatePosition by %.3g at %d points\n",
+                    error, sizes[s]);
+            failed = 1;
+        }
+        error = quatError(&input);
+        if (error > QUAT_TOLERANCE) {
+            fprintf(stderr, "Error: Batched quaternion blends differ from quat_nlerp / quat_slerp by %.3g\n",
+                    error);
+            failed = 1;
+        }
+
+        for (int b = 0; b < NUM_BENCHMARKS; b++) {
+            if (filter && !strstr(benchmarks[b].name, filter)) continue;
+
+            BenchStats stats = runBenchmark(&benchmarks[b], &input, repetitions, warmupMs, minTimeMs);
+            fprintf(table, "%-34s %9d %11.2f %9.3f %6.1f%% %11.2f\n",
+                    benchmarks[b].name, sizes[s], stats.median, stats.mad,
+                    100.0 * stats.mad / stats.median, stats.min);
+            if (json) {
+                writeJsonResult(json, first, benchmarks[b].name, sizes[s], &stats);
+                first = 0;
+            }
+        }
+        fprintf(table, "\n");
+        freeInput(&input);
+    }
+
+    if (json) {
+        fprintf(json, "\n  ]\n}\n");
+        if (json != stdout) {
+            fclose(json);
+            fprintf(table, "Results written to %s\n", jsonPath);
+        }
+    }
+    return failed ? 1 : 0;
+}
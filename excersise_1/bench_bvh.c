@@ -0,0 +1,208 @@
+/*
+ * ============================================================================
+ * CLOSEST-POINT QUERIES - BVH VS BRUTE FORCE
+ * ============================================================================
+ *
+ * Builds a SegmentBVH over a long synthetic path and times closest-point
+ * queries three ways: one bspline_closestPoint per query, one
+ * bspline_closestPointBatch over queries ordered along the path, and brute
+ * force (bspline_closestPointOnSegment on every segment). Brute force also
+ * checks that the hierarchy returns the same distances, and a symmetric
+ * segment whose minimum sits exactly on a solver sample checks the solver
+ * itself. Build and refit times are reported as well, including the
+ * partial refit after one control point moves, which must leave the same
+ * boxes as a full refit.
+ *
+ * Usage: ./bench_bvh [numControlPoints] [numQueries]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "bspline.h"
+#include "bspline_curve.h"
+#include "bspline_bvh.h"
+#include "bspline_editable.h"
+#include "bench_common.h"
+
+// Timed runs per measurement (best one is reported)
+#define BENCH_REPETITIONS 5
+
+// Brute force is slow; it only runs on the first queries
+#define MAX_BRUTE_FORCE_QUERIES 200
+
+// Queries lie within this distance of the curve
+#define QUERY_OFFSET 2.0
+
+/**
+ * Points scattered around the curve, ordered along it (coherent batch)
+ */
+static Vec3* createQueries(const BSplineCurve* curve, int count) {
+    Vec3* queries = (Vec3*)malloc((size_t)count * sizeof(Vec3));
+    if (!queries) return NULL;
+
+    unsigned int seed = 54321u;
+    for (int i = 0; i < count; i++) {
+        double position = (double)i * curve->numSegments / count;
+        int segment = 1 + (int)position;
+        Vec3 p = bspline_curvePosition(curve, segment, (float)(position - (segment - 1)));
+        queries[i].x = p.x + QUERY_OFFSET * (bench_nextRandom(&seed) / 16384.0 - 1.0);
+        queries[i].y = p.y + QUERY_OFFSET * (bench_nextRandom(&seed) / 16384.0 - 1.0);
+        queries[i].z = p.z + QUERY_OFFSET * (bench_nextRandom(&seed) / 16384.0 - 1.0);
+    }
+    return queries;
+}
+
+static CurveHit bruteForce(const BSplineCurve* curve, Vec3 query) {
+    CurveHit best = bspline_closestPointOnSegment(curve, 1, query);
+    for (int seg = 2; seg <= curve->numSegments; seg++) {
+        CurveHit hit = bspline_closestPointOnSegment(curve, seg, query);
+        if (hit.distance < best.distance) best = hit;
+    }
+    return best;
+}
+
+/**
+ * Symmetric arch queried from above its apex
+ *
+ * The slope of the distance is exactly 0 at t = 0.5, which is also a sample
+ * of the local solver, so a sign-change-only search misses it and returns an
+ * endpoint instead. Brute force shares that solver, hence a known answer.
+ */
+static int checkSymmetricSegment(void) {
+    Vec3 arch[4] = {{-3.0, 0.0, 0.0}, {-1.0, 1.0, 0.0}, {1.0, 1.0, 0.0}, {3.0, 0.0, 0.0}};
+    Vec3 query = {0.0, 5.0, 0.0};
+
+    BSplineCurve* curve = bspline_compileCurve(arch, 4);
+    SegmentBVH* bvh = curve ? bspline_buildBVH(arch, 4, curve) : NULL;
+    if (!bvh) {
+        bspline_freeCurve(curve);
+        return 0;
+    }
+
+    Vec3 apex = bspline_curvePosition(curve, 1, 0.5f);
+    double expected = sqrt((apex.x - query.x) * (apex.x - query.x) +
+                           (apex.y - query.y) * (apex.y - query.y) +
+                           (apex.z - query.z) * (apex.z - query.z));
+
+    CurveHit hit;
+    int ok = bspline_closestPoint(bvh, query, &hit) &&
+             fabs(hit.t - 0.5f) < 1e-6f &&
+             fabs(hit.distance - expected) < 1e-9 * (1.0 + expected);
+    printf("Symmetric segment: t = %.4f, distance %.4f (expected 0.5000, %.4f)\n\n",
+           hit.t, hit.distance, expected);
+
+    bspline_freeBVH(bvh);
+    bspline_freeCurve(curve);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    int numControlPoints = (argc > 1) ? atoi(argv[1]) : 20000;
+    int numQueries = (argc > 2) ? atoi(argv[2]) : 1000;
+
+    if (numControlPoints < 4 || numQueries < 1) {
+        fprintf(stderr, "Error: Need at least 4 control points and 1 query\n");
+        return 1;
+    }
+
+    Vec3* points = bench_createLongPath(numControlPoints);
+    BSplineCurve* curve = points ? bspline_compileCurve(points, numControlPoints) : NULL;
+    Vec3* queries = curve ? createQueries(curve, numQueries) : NULL;
+    CurveHit* hits = (CurveHit*)malloc((size_t)numQueries * sizeof(CurveHit));
+    if (!queries || !hits) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+
+    double start = bench_nowSeconds();
+    SegmentBVH* bvh = bspline_buildBVH(points, numControlPoints, curve);
+    double buildTime = bench_nowSeconds() - start;
+    if (!bvh) return 1;
+
+    start = bench_nowSeconds();
+    bspline_refitBVH(bvh, points);
+    double refitTime = bench_nowSeconds() - start;
+
+    // One edit: partial refit, then a full refit must not change any box
+    int moved = numControlPoints / 2;
+    int firstChanged, lastChanged;
+    bspline_affectedSegments(moved, curve->numSegments, &firstChanged, &lastChanged);
+    Vec3 original = points[moved];
+    points[moved].z += 1.0;
+    start = bench_nowSeconds();
+    bspline_refitBVHSegments(bvh, points, firstChanged, lastChanged);
+    double editRefitTime = bench_nowSeconds() - start;
+
+    AABB* boxes = (AABB*)malloc((size_t)bvh->numNodes * sizeof(AABB));
+    int editRefitOk = boxes != NULL;
+    for (int i = 0; editRefitOk && i < bvh->numNodes; i++) boxes[i] = bvh->nodes[i].box;
+    bspline_refitBVH(bvh, points);
+    for (int i = 0; editRefitOk && i < bvh->numNodes; i++) {
+        editRefitOk = memcmp(&boxes[i], &bvh->nodes[i].box, sizeof(AABB)) == 0;
+    }
+    free(boxes);
+    points[moved] = original;
+    bspline_refitBVH(bvh, points);
+
+    printf("=== Closest-Point Queries ===\n");
+    printf("Control points:  %d\n", numControlPoints);
+    printf("Queries:         %d (within %.1f of the curve)\n", numQueries, QUERY_OFFSET);
+    printf("BVH nodes:       %d\n", bvh->numNodes);
+    printf("Build:           %.3f ms\n", buildTime * 1000.0);
+    printf("Refit:           %.3f ms\n", refitTime * 1000.0);
+    printf("Refit one edit:  %.3f ms (%s full refit)\n\n", editRefitTime * 1000.0,
+           editRefitOk ? "matches" : "DIFFERS FROM");
+
+    int symmetricOk = checkSymmetricSegment();
+    printf("%-22s %14s %10s\n", "method", "per query [us]", "speedup");
+
+    // One query at a time
+    double single = 1e30;
+    for (int rep = 0; rep < BENCH_REPETITIONS; rep++) {
+        start = bench_nowSeconds();
+        for (int i = 0; i < numQueries; i++) {
+            bspline_closestPoint(bvh, queries[i], &hits[i]);
+        }
+        double elapsed = (bench_nowSeconds() - start) / numQueries;
+        if (elapsed < single) single = elapsed;
+    }
+
+    // Coherent batch (warm-started from the previous hit)
+    double batch = 1e30;
+    for (int rep = 0; rep < BENCH_REPETITIONS; rep++) {
+        start = bench_nowSeconds();
+        bspline_closestPointBatch(bvh, queries, numQueries, hits);
+        double elapsed = (bench_nowSeconds() - start) / numQueries;
+        if (elapsed < batch) batch = elapsed;
+    }
+
+    // Brute force over every segment, on a subset
+    int numBrute = numQueries < MAX_BRUTE_FORCE_QUERIES ? numQueries : MAX_BRUTE_FORCE_QUERIES;
+    int mismatches = 0;
+    start = bench_nowSeconds();
+    for (int i = 0; i < numBrute; i++) {
+        int q = (int)((long)i * numQueries / numBrute);
+        CurveHit expected = bruteForce(curve, queries[q]);
+        if (fabs(expected.distance - hits[q].distance) > 1e-9 * (1.0 + expected.distance)) {
+            mismatches++;
+        }
+    }
+    double brute = (bench_nowSeconds() - start) / numBrute;
+
+    printf("%-22s %14.2f %9.0fx\n", "brute force", brute * 1e6, 1.0);
+    printf("%-22s %14.2f %9.0fx\n", "bspline_closestPoint", single * 1e6, brute / single);
+    printf("%-22s %14.2f %9.0fx\n", "closestPointBatch", batch * 1e6, brute / batch);
+    printf("\nBVH matches brute force: %s (%d of %d queries differ)\n",
+           mismatches == 0 ? "yes" : "NO", mismatches, numBrute);
+    printf("Symmetric segment minimum found: %s\n", symmetricOk ? "yes" : "NO");
+
+    bspline_freeBVH(bvh);
+    free(hits);
+    free(queries);
+    bspline_freeCurve(curve);
+    free(points);
+    return (mismatches == 0 && symmetricOk && editRefitOk) ? 0 : 1;
+}
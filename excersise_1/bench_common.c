@@ -0,0 +1,30 @@
+#include "bench_common.h"
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+double bench_nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+unsigned int bench_nextRandom(unsigned int* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return (*seed >> 16) & 0x7fff;
+}
+
+Vec3* bench_createLongPath(int count) {
+    Vec3* points = (Vec3*)malloc((size_t)count * sizeof(Vec3));
+    if (!points) return NULL;
+
+    unsigned int seed = 12345u;
+    for (int i = 0; i < count; i++) {
+        double noise = bench_nextRandom(&seed) / 32768.0 - 0.5;
+        double angle = i * 0.35;
+        points[i].x = 10.0 * cos(angle) + noise;
+        points[i].y = 10.0 * sin(angle) - noise;
+        points[i].z = i * 0.05;
+    }
+    return points;
+}
@@ -0,0 +1,35 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include "bspline.h"
+
+// ============================================================================
+// SHARED BENCHMARK HELPERS
+// Timer, pseudo-random numbers and the synthetic test path used by every
+// bench_* program, so all of them time and evaluate the same curve.
+// ============================================================================
+
+/**
+ * Monotonic time
+ *
+ * @return Seconds since an arbitrary fixed point
+ */
+double bench_nowSeconds(void);
+
+/**
+ * Deterministic linear congruential generator
+ *
+ * @param seed Generator state, advanced in place
+ * @return Next value in [0, 32767]
+ */
+unsigned int bench_nextRandom(unsigned int* seed);
+
+/**
+ * Long wobbly helix - deterministic, no two segments alike
+ *
+ * @param count Number of control points
+ * @return Newly allocated points (free with free()), NULL if out of memory
+ */
+Vec3* bench_createLongPath(int count);
+
+#endif // BENCH_COMMON_H
@@ -0,0 +1,217 @@
+/*
+ * ============================================================================
+ * STREAMED TRAVERSAL THROUGH A PIPE
+ * ============================================================================
+ *
+ * A writer thread sends a long synthetic path through a pipe, as text, as a
+ * float64 binary path file and as a float32 one. The main thread follows it
+ * with a PathStream (bspline_stream.h) whose window is far smaller than the
+ * path, evaluates every segment, and compares each result with the same
+ * path written to a temporary file and mapped with pathfile_open: float64
+ * points are evaluated in place through curve_fromControlPoints, float32
+ * ones after pathfile_widenPoints. Reports control points per second
+ * through the pipe.
+ *
+ * Usage: ./bench_stream [numControlPoints] [windowSize]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "bspline.h"
+#include "bspline_stream.h"
+#include "path_file.h"
+#include "curve_evaluator.h"
+#include "bench_common.h"
+
+// Parameters evaluated per segment
+#define SAMPLES_PER_SEGMENT 4
+
+/**
+ * What the writer thread sends
+ */
+typedef struct {
+    const Vec3* points;
+    int numPoints;
+    int fd;                  // Write end of the pipe (closed by the writer)
+    int binary;              // 0: text, 1: binary path file
+    PathPrecision precision; // Binary only
+    int ok;
+} WriterJob;
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+static void* writerMain(void* arg) {
+    WriterJob* job = (WriterJob*)arg;
+
+    if (job->binary) {
+        // pathfile_write only writes sequentially, so the pipe can be its file
+        char name[32];
+        snprintf(name, sizeof(name), "/dev/fd/%d", job->fd);
+        job->ok = pathfile_write(name, job->points, job->numPoints, job->precision, NULL, 0, 3);
+        close(job->fd);
+        return NULL;
+    }
+
+    FILE* out = fdopen(job->fd, "w");
+    if (!out) {
+        close(job->fd);
+        job->ok = 0;
+        return NULL;
+    }
+    fprintf(out, "# bench_stream: %d control points\n", job->numPoints);
+    for (int i = 0; i < job->numPoints; i++) {
+        const Vec3* p = &job->points[i];
+        fprintf(out, "%.17g %.17g %.17g\n", p->x, p->y, p->z);
+    }
+    job->ok = !ferror(out);
+    if (fclose(out) != 0) job->ok = 0;
+    return NULL;
+}
+
+// ============================================================================
+// TRAVERSAL
+// ============================================================================
+
+static int sameVec3(Vec3 a, Vec3 b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+/**
+ * Stream the path through a pipe and check every segment against `expected`
+ *
+ * @return Mismatching evaluations, or -1 if streaming failed
+ */
+static long streamAndCompare(WriterJob* job, const CurveEvaluator* expected, int windowSize, double* outSeconds) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        fprintf(stderr, "Error: Cannot create pipe\n");
+        return -1;
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "/dev/fd/%d", fds[0]);
+    job->fd = fds[1];
+
+    double start = bench_nowSeconds();
+    pthread_t writer;
+    if (pthread_create(&writer, NULL, writerMain, job) != 0) {
+        fprintf(stderr, "Error: Failed to start writer thread\n");
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+
+    PathStream* stream = bspline_openStream(name, windowSize);
+    close(fds[0]);  // The stream opened its own descriptor
+    if (!stream) {
+        pthread_join(writer, NULL);
+        return -1;
+    }
+
+    long mismatches = 0;
+    int numSegments = bspline_getNumSegments(job->numPoints);
+    int seg = 1;
+    for (; bspline_streamRequest(stream, seg, 1) == 1; seg++) {
+        for (int i = 0; i < SAMPLES_PER_SEGMENT; i++) {
+            float t = (float)i / (float)(SAMPLES_PER_SEGMENT - 1);
+            if (!sameVec3(bspline_streamPosition(stream, seg, t), curve_position(expected, seg, t)) ||
+                !sameVec3(bspline_streamTangent(stream, seg, t), curve_tangent(expected, seg, t))) {
+                mismatches++;
+            }
+        }
+    }
+    long pointsRead = bspline_streamPointsRead(stream);
+    bspline_closeStream(stream);
+    pthread_join(writer, NULL);
+    *outSeconds = bench_nowSeconds() - start;
+
+    if (!job->ok || seg - 1 != numSegments || pointsRead != job->numPoints) {
+        fprintf(stderr, "Error: Streamed %d of %d segments (%ld points read)\n",
+                seg - 1, numSegments, pointsRead);
+        return -1;
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv) {
+    int numControlPoints = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int windowSize = (argc > 2) ? atoi(argv[2]) : 1024;
+
+    if (numControlPoints < 4 || windowSize < 8) {
+        fprintf(stderr, "Error: Need at least 4 control points and a window of 8\n");
+        return 1;
+    }
+
+    Vec3* points = bench_createLongPath(numControlPoints);
+    if (!points) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+
+    // Reference: the same path as mapped files, float64 read in place
+    MappedPath* mapped[2] = {NULL, NULL};
+    Vec3* widened = NULL;
+    CurveEvaluator reference[2];
+    static const PathPrecision precisions[2] = {PATH_PRECISION_FLOAT64, PATH_PRECISION_FLOAT32};
+    for (int p = 0; p < 2; p++) {
+        char name[] = "/tmp/bench_stream_XXXXXX";
+        int fd = mkstemp(name);
+        if (fd < 0) {
+            fprintf(stderr, "Error: Cannot create temporary path file\n");
+            return 1;
+        }
+        close(fd);
+        if (pathfile_write(name, points, numControlPoints, precisions[p], NULL, 0, 3)) {
+            mapped[p] = pathfile_open(name);
+        }
+        unlink(name);  // The mapping stays valid
+        const Vec3* mappedPoints = NULL;
+        if (mapped[p]) {
+            mappedPoints = (p == 0) ? mapped[p]->points : pathfile_widenPoints(mapped[p], &widened);
+        }
+        if (!mappedPoints) {
+            fprintf(stderr, "Error: Cannot map the reference path\n");
+            return 1;
+        }
+        reference[p] = curve_fromControlPoints(mappedPoints, numControlPoints);
+    }
+
+    printf("=== Streamed Traversal ===\n");
+    printf("Control points:  %d\n", numControlPoints);
+    printf("Window:          %d points (%.1f KB)\n\n", windowSize, windowSize * sizeof(Vec3) / 1024.0);
+    printf("%-10s %10s %16s %12s\n", "format", "time [ms]", "points/s", "mismatches");
+
+    const char* names[] = {"text", "float64", "float32"};
+    const CurveEvaluator* expected[] = {&reference[0], &reference[0], &reference[1]};
+    int failed = 0;
+
+    for (int f = 0; f < 3; f++) {
+        WriterJob job = {points, numControlPoints, -1, f > 0,
+                         f == 2 ? PATH_PRECISION_FLOAT32 : PATH_PRECISION_FLOAT64, 0};
+        double seconds = 0.0;
+        long mismatches = streamAndCompare(&job, expected[f], windowSize, &seconds);
+        if (mismatches < 0) {
+            printf("%-10s %10s %16s %12s\n", names[f], "-", "-", "FAILED");
+            failed = 1;
+            continue;
+        }
+        printf("%-10s %10.1f %16.0f %12ld\n", names[f], seconds * 1000.0,
+               numControlPoints / seconds, mismatches);
+        if (mismatches > 0) failed = 1;
+    }
+
+    printf("\nStream matches the mapped path files: %s\n", failed ? "NO" : "yes");
+
+    free(widened);
+    pathfile_close(mapped[0]);
+    pathfile_close(mapped[1]);
+    free(points);
+    return failed ? 1 : 0;
+}
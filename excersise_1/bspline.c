@@ -3,13 +3,6 @@
 #include <stdlib.h>
 #include <math.h>
 
-// OpenGL header for orientation functions (optional - only needed if using bspline_applyOrientation)
-#ifdef __APPLE__
-    #include <GLUT/glut.h>
-#else
-    #include <GL/glut.h>
-#endif
-
 // ============================================================================
 // UNIFORM CUBIC B-SPLINE IMPLEMENTATION
 // Based on equations 1.2, 1.3, and 1.4 from the assignment
@@ -331,23 +324,6 @@ EulerAngles bspline_getEulerAngles(Vec3 tangent, Vec3 worldUp) {
     return angles;
 }
 
-/**
- * Apply Euler angles orientation in OpenGL
- * 
- * Call this after glTranslatef to apply orientation.
- * Order: Yaw → Pitch → Roll
- * 
- * @param angles Euler angles in degrees
- */
-void bspline_applyOrientation(EulerAngles angles) {
-    // OpenGL rotations are applied in reverse order
-    // We want: Yaw → Pitch → Roll
-    // So we write: Roll → Pitch → Yaw
-    glRotatef(angles.roll, 1.0f, 0.0f, 0.0f);   // Roll around X
-    glRotatef(angles.pitch, 0.0f, 1.0f, 0.0f);  // Pitch around Y
-    glRotatef(angles.yaw, 0.0f, 0.0f, 1.0f);    // Yaw around Z
-}
-
 // ============================================================================
 // AXIS-ANGLE ROTATION (Section 1.4)
 // ============================================================================
@@ -426,17 +402,6 @@ AxisAngle bspline_computeAxisAngle(Vec3 start, Vec3 end) {
     return result;
 }
 
-/**
- * Apply axis-angle rotation in OpenGL
- * 
- * Convenience wrapper for glRotatef with AxisAngle structure.
- * 
- * @param aa Axis-angle rotation (angle in degrees, axis as normalized vector)
- */
-void bspline_applyAxisAngle(AxisAngle aa) {
-    glRotatef(aa.angle, aa.axis.x, aa.axis.y, aa.axis.z);
-}
-
 // ============================================================================
 // DCM MATRIX ORIENTATION (Section 1.6 - Frenet-Serret Frame)
 // ============================================================================
@@ -502,15 +467,30 @@ Vec3 bspline_evaluateSecondDerivative(const Vec3* controlPoints, int segment, fl
  * @return Frenet-Serret frame with normalized tangent, normal, binormal
  */
 FrenetFrame bspline_computeFrenetFrame(const Vec3* controlPoints, int segment, float t) {
-    FrenetFrame frame;
-    
     // 1. Tangent (w) - first derivative p'(t)
     Vec3 firstDeriv = bspline_evaluateTangent(controlPoints, segment, t);
-    frame.tangent = bspline_normalize(firstDeriv);
     
     // 2. Second derivative p''(t)
     Vec3 secondDeriv = bspline_evaluateSecondDerivative(controlPoints, segment, t);
     
+    return bspline_frenetFromDerivatives(firstDeriv, secondDeriv);
+}
+
+/**
+ * Build Frenet-Serret frame from p'(t) and p''(t)
+ * 
+ * Shared by bspline_computeFrenetFrame and the fused evaluators, so the
+ * frame construction (and its degenerate case) lives in one place.
+ * 
+ * @param firstDeriv p'(t)
+ * @param secondDeriv p''(t)
+ * @return Frenet-Serret frame with normalized tangent, normal, binormal
+ */
+FrenetFrame bspline_frenetFromDerivatives(Vec3 firstDeriv, Vec3 secondDeriv) {
+    FrenetFrame frame;
+    
+    frame.tangent = bspline_normalize(firstDeriv);
+    
     // 3. Normal (u) - equation 1.7: u = p'(t) × p''(t)
     Vec3 normalRaw = bspline_cross(firstDeriv, secondDeriv);
     double normalLen = bspline_length(normalRaw);
@@ -618,23 +598,58 @@ void bspline_frenetToMatrix(FrenetFrame frame, float matrix[16], int useInverse)
     }
 }
 
+// ============================================================================
+// FUSED EVALUATION
+// ============================================================================
+
 /**
- * Apply Frenet-Serret frame orientation in OpenGL
- * 
- * This function applies the DCM matrix (equation 1.9) to orient the object
- * along the curve using the tangent, normal, and binormal vectors.
- * 
- * The object's local X-axis will align with the tangent (forward),
- * Y-axis with the normal (up), and Z-axis with the binormal (right).
+ * Evaluate p(t), p'(t) and p''(t) in one pass
  * 
- * Call this after glTranslatef to apply orientation.
+ * The three coefficient rows are
+ *   c   = (1/6) * [t^3, t^2, t, 1] * B_{i,3}
+ *   c'  = (1/6) * [3t^2, 2t, 1, 0] * B_{i,3}
+ *   c'' = (1/6) * [6t, 2, 0, 0]    * B_{i,3}
+ * and each control point of R_i is read once and blended into all three.
  * 
- * @param frame Frenet-Serret frame
+ * @param controlPoints Array of control points
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1)
+ * @param outFrame Optional output Frenet-Serret frame (NULL to skip)
+ * @return p, p' and p'' at t
  */
-void bspline_applyFrenetFrame(FrenetFrame frame) {
-    float matrix[16];
-    bspline_frenetToMatrix(frame, matrix, 1);  // Use inverse (transpose)
-    glMultMatrixf(matrix);
+CurveJet bspline_evaluateJet(const Vec3* controlPoints, int segment, float t, FrenetFrame* outFrame) {
+    float c0[4], c1[4], c2[4];
+    bspline_computeCoefficients(t, c0);
+    bspline_computeDerivativeCoefficients(t, c1);
+    
+    float Tdouble[4] = {6.0f * t, 2.0f, 0.0f, 0.0f};
+    for (int j = 0; j < 4; j++) {
+        c2[j] = 0.0f;
+        for (int i = 0; i < 2; i++) {  // Last two entries of T'' are zero
+            c2[j] += Tdouble[i] * B_SPLINE_BASIS[i][j];
+        }
+        c2[j] /= 6.0f;
+    }
+    
+    CurveJet jet = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+    for (int k = 0; k < 4; k++) {
+        Vec3 r = controlPoints[segment - 1 + k];
+        jet.position.x += c0[k] * r.x;
+        jet.position.y += c0[k] * r.y;
+        jet.position.z += c0[k] * r.z;
+        jet.tangent.x += c1[k] * r.x;
+        jet.tangent.y += c1[k] * r.y;
+        jet.tangent.z += c1[k] * r.z;
+        jet.secondDerivative.x += c2[k] * r.x;
+        jet.secondDerivative.y += c2[k] * r.y;
+        jet.secondDerivative.z += c2[k] * r.z;
+    }
+    
+    if (outFrame) {
+        *outFrame = bspline_frenetFromDerivatives(jet.tangent, jet.secondDerivative);
+    }
+    
+    return jet;
 }
 
 // ============================================================================
@@ -33,6 +33,13 @@ typedef struct {
     Vec3 binormal;  // v vector (perpendicular to both)
 } FrenetFrame;
 
+// Curve point with its first two derivatives (all from one evaluation)
+typedef struct {
+    Vec3 position;          // p(t)   - equation 1.2
+    Vec3 tangent;           // p'(t)  - equation 1.3 (unnormalized)
+    Vec3 secondDerivative;  // p''(t)
+} CurveJet;
+
 // ============================================================================
 // CORE B-SPLINE FUNCTIONS
 // ============================================================================
@@ -146,16 +153,6 @@ double bspline_length(Vec3 v);
  */
 EulerAngles bspline_getEulerAngles(Vec3 tangent, Vec3 worldUp);
 
-/**
- * Apply Euler angles orientation in OpenGL
- * 
- * Call this after glTranslatef to apply orientation.
- * Applies rotations in order: Roll → Pitch → Yaw
- * 
- * @param angles Euler angles in degrees
- */
-void bspline_applyOrientation(EulerAngles angles);
-
 // ============================================================================
 // AXIS-ANGLE ROTATION (Section 1.4)
 // ============================================================================
@@ -175,16 +172,6 @@ void bspline_applyOrientation(EulerAngles angles);
  */
 AxisAngle bspline_computeAxisAngle(Vec3 start, Vec3 end);
 
-/**
- * Apply axis-angle rotation in OpenGL
- * 
- * Convenience function for applying AxisAngle rotation.
- * Equivalent to: glRotatef(aa.angle, aa.axis.x, aa.axis.y, aa.axis.z)
- * 
- * @param aa Axis-angle rotation
- */
-void bspline_applyAxisAngle(AxisAngle aa);
-
 // ============================================================================
 // DCM MATRIX ORIENTATION (Section 1.6 - Frenet-Serret Frame)
 // ============================================================================
@@ -237,16 +224,36 @@ FrenetFrame bspline_computeFrenetFrame(const Vec3* controlPoints, int segment, f
 void bspline_frenetToMatrix(FrenetFrame frame, float matrix[16], int useInverse);
 
 /**
- * Apply Frenet-Serret frame orientation in OpenGL
+ * Build Frenet-Serret frame from already evaluated derivatives
  * 
- * Applies DCM matrix (equation 1.9) to orient object along curve
- * using tangent, normal, and binormal vectors.
+ * Same construction as bspline_computeFrenetFrame (equations 1.7, 1.8),
+ * including the degenerate-normal fallback, without re-evaluating the curve.
  * 
- * Call after glTranslatef to apply orientation.
+ * @param firstDeriv p'(t)
+ * @param secondDeriv p''(t)
+ * @return Frenet-Serret frame with normalized tangent, normal, binormal
+ */
+FrenetFrame bspline_frenetFromDerivatives(Vec3 firstDeriv, Vec3 secondDeriv);
+
+// ============================================================================
+// FUSED EVALUATION
+// ============================================================================
+
+/**
+ * Evaluate position, tangent and second derivative in one pass
  * 
- * @param frame Frenet-Serret frame
+ * Loads the four control points of the segment once and blends them with
+ * all three coefficient rows - replaces separate calls to
+ * bspline_evaluatePosition, bspline_evaluateTangent and
+ * bspline_evaluateSecondDerivative.
+ * 
+ * @param controlPoints Array of control points
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1)
+ * @param outFrame Optional output Frenet-Serret frame (NULL to skip)
+ * @return p, p' and p'' at t
  */
-void bspline_applyFrenetFrame(FrenetFrame frame);
+CurveJet bspline_evaluateJet(const Vec3* controlPoints, int segment, float t, FrenetFrame* outFrame);
 
 // ============================================================================
 // INTERNAL HELPER FUNCTIONS
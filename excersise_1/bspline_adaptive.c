@@ -0,0 +1,302 @@
+#include "bspline_adaptive.h"
+#include "frustum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Midpoint subdivision depth limit (at most 2^depth lines per segment)
+#define ADAPTIVE_MAX_DEPTH 10
+
+// Initial vertex capacity of a segment's cache
+#define ADAPTIVE_INITIAL_PER_SEGMENT 8
+
+// ============================================================================
+// DEVIATION MEASURE
+// ============================================================================
+
+/**
+ * Point in the space the tolerance is measured in
+ *
+ * World space: unchanged. Screen space: pixel coordinates (x, y, 0).
+ * Returns 0 for points at or behind the eye (no meaningful pixel position);
+ * subdivide splits intervals that cross the eye plane.
+ */
+static int toMeasureSpace(const TessellationTolerance* tol, Vec3 p, Vec3* out) {
+    if (!tol->screenSpace) {
+        *out = p;
+        return 1;
+    }
+
+    const double* m = tol->viewProjection;
+    double x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+    double y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+    double w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
+    if (w <= 1e-9) return 0;
+
+    out->x = (x / w * 0.5 + 0.5) * tol->viewportWidth;
+    out->y = (y / w * 0.5 + 0.5) * tol->viewportHeight;
+    out->z = 0.0;
+    return 1;
+}
+
+/**
+ * Distance from p to the chord [a, b]
+ */
+static double chordDistance(Vec3 a, Vec3 b, Vec3 p) {
+    Vec3 ab = {b.x - a.x, b.y - a.y, b.z - a.z};
+    Vec3 ap = {p.x - a.x, p.y - a.y, p.z - a.z};
+    double len2 = ab.x * ab.x + ab.y * ab.y + ab.z * ab.z;
+    double s = (len2 > 1e-18) ? (ap.x * ab.x + ap.y * ab.y + ap.z * ab.z) / len2 : 0.0;
+    if (s < 0.0) s = 0.0;
+    if (s > 1.0) s = 1.0;
+    double dx = ap.x - s * ab.x, dy = ap.y - s * ab.y, dz = ap.z - s * ab.z;
+    return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// ============================================================================
+// SUBDIVISION
+// ============================================================================
+
+static int appendVertex(AdaptiveSegment* out, Vec3 p) {
+    if (out->numVertices == out->capacity) {
+        int capacity = out->capacity ? out->capacity * 2 : ADAPTIVE_INITIAL_PER_SEGMENT;
+        float* grown = (float*)realloc(out->vertices, (size_t)capacity * 3 * sizeof(float));
+        if (!grown) return 0;
+        out->vertices = grown;
+        out->capacity = capacity;
+    }
+
+    float* v = out->vertices + 3 * out->numVertices++;
+    v[0] = (float)p.x;
+    v[1] = (float)p.y;
+    v[2] = (float)p.z;
+    return 1;
+}
+
+/**
+ * Emit vertices of (t0, t1]; p0 / p1 are the interval end points
+ *
+ * The chord is tested against the curve at t = 1/4, 1/2 and 3/4 of the
+ * interval, which also catches S-shaped pieces whose midpoint lies on it.
+ * A point at or behind the eye has no pixel position, so an interval that
+ * crosses the eye plane counts as over tolerance and is split down to the
+ * depth limit; its halves in front of the eye are then measured normally.
+ * Only an interval with every tested point behind the eye keeps its chord,
+ * which is then behind the eye as well and never drawn.
+ */
+static int subdivide(AdaptiveSegment* out, const CurveEvaluator* curve, int segment,
+                     const TessellationTolerance* tol, float t0, Vec3 p0, float t1, Vec3 p1, int depth) {
+    float tm = 0.5f * (t0 + t1);
+    Vec3 pm = curve_position(curve, segment, tm);
+
+    if (depth < ADAPTIVE_MAX_DEPTH) {
+        Vec3 points[5] = {p0, p1, pm,
+                          curve_position(curve, segment, 0.5f * (t0 + tm)),
+                          curve_position(curve, segment, 0.5f * (tm + t1))};
+        Vec3 measured[5];
+        int inFront = 0;
+        for (int i = 0; i < 5; i++) inFront += toMeasureSpace(tol, points[i], &measured[i]);
+
+        int overTolerance = (inFront > 0);
+        if (inFront == 5) {
+            double deviation = 0.0;
+            for (int i = 2; i < 5; i++) {
+                double d = chordDistance(measured[0], measured[1], measured[i]);
+                if (d > deviation) deviation = d;
+            }
+            overTolerance = deviation > tol->tolerance;
+        }
+
+        if (overTolerance) {
+            return subdivide(out, curve, segment, tol, t0, p0, tm, pm, depth + 1) &&
+                   subdivide(out, curve, segment, tol, tm, pm, t1, p1, depth + 1);
+        }
+    }
+
+    return appendVertex(out, p1);
+}
+
+/**
+ * Size the per-segment cache for the curve (all segments start stale)
+ */
+static int resizeSegments(AdaptiveTessellation* tess, int numSegments) {
+    if (tess->segments && tess->numSegments == numSegments) return 1;
+
+    if (tess->segments) {
+        for (int i = 0; i < tess->numSegments; i++) free(tess->segments[i].vertices);
+        free(tess->segments);
+    }
+    tess->segments = (AdaptiveSegment*)calloc(numSegments, sizeof(AdaptiveSegment));
+    int* first = (int*)realloc(tess->segmentFirst, (numSegments + 1) * sizeof(int));
+    if (first) tess->segmentFirst = first;
+    tess->numSegments = (tess->segments && first) ? numSegments : 0;
+    tess->valid = 0;
+    return tess->numSegments == numSegments;
+}
+
+/**
+ * Copy the per-segment vertices into one continuous strip
+ */
+static int packStrip(AdaptiveTessellation* tess, const CurveEvaluator* curve) {
+    int total = 1;
+    for (int i = 0; i < tess->numSegments; i++) total += tess->segments[i].numVertices;
+
+    if (total > tess->capacity) {
+        float* grown = (float*)realloc(tess->vertices, (size_t)total * 3 * sizeof(float));
+        if (!grown) return 0;
+        tess->vertices = grown;
+        tess->capacity = total;
+    }
+
+    Vec3 start = curve_position(curve, 1, 0.0f);
+    tess->vertices[0] = (float)start.x;
+    tess->vertices[1] = (float)start.y;
+    tess->vertices[2] = (float)start.z;
+    tess->numVertices = 1;
+
+    for (int i = 0; i < tess->numSegments; i++) {
+        const AdaptiveSegment* seg = &tess->segments[i];
+        tess->segmentFirst[i] = tess->numVertices - 1;
+        memcpy(tess->vertices + 3 * tess->numVertices, seg->vertices, (size_t)seg->numVertices * 3 * sizeof(float));
+        tess->numVertices += seg->numVertices;
+    }
+    tess->segmentFirst[tess->numSegments] = tess->numVertices - 1;
+    return 1;
+}
+
+/**
+ * Would both tolerances produce the same tessellation?
+ */
+static int sameTolerance(const TessellationTolerance* a, const TessellationTolerance* b) {
+    if (a->tolerance != b->tolerance || a->screenSpace != b->screenSpace) return 0;
+    if (!a->screenSpace) return 1;  // World space does not depend on the view
+
+    if (a->viewportWidth != b->viewportWidth || a->viewportHeight != b->viewportHeight) return 0;
+    for (int i = 0; i < 16; i++) {
+        if (a->viewProjection[i] != b->viewProjection[i]) return 0;
+    }
+    return 1;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void bspline_initAdaptiveTessellation(AdaptiveTessellation* tess) {
+    if (tess) memset(tess, 0, sizeof(AdaptiveTessellation));
+}
+
+TessellationTolerance bspline_worldTolerance(double tolerance) {
+    TessellationTolerance tol;
+    memset(&tol, 0, sizeof(tol));
+    tol.tolerance = tolerance;
+    return tol;
+}
+
+TessellationTolerance bspline_screenTolerance(double pixels, const double* projection, const double* modelview,
+                                              double viewportWidth, double viewportHeight) {
+    TessellationTolerance tol;
+    memset(&tol, 0, sizeof(tol));
+    tol.tolerance = pixels;
+    tol.screenSpace = 1;
+    tol.viewportWidth = viewportWidth;
+    tol.viewportHeight = viewportHeight;
+
+    // viewProjection = projection * modelview (column-major)
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            double sum = 0.0;
+            for (int k = 0; k < 4; k++) {
+                sum += projection[k * 4 + r] * modelview[c * 4 + k];
+            }
+            tol.viewProjection[c * 4 + r] = sum;
+        }
+    }
+    return tol;
+}
+
+int bspline_updateAdaptiveTessellation(AdaptiveTessellation* tess, const CurveEvaluator* curve,
+                                       const AABB* bounds, const TessellationTolerance* tolerance) {
+    if (!tess || !curve || !tolerance || curve->numSegments <= 0 || tolerance->tolerance <= 0.0) {
+        fprintf(stderr, "Error: Invalid adaptive tessellation request\n");
+        return -1;
+    }
+    if (!resizeSegments(tess, curve->numSegments)) {
+        fprintf(stderr, "Error: Failed to allocate adaptive tessellation\n");
+        return -1;
+    }
+
+    if (!sameTolerance(&tess->tolerance, tolerance)) {
+        bspline_invalidateAdaptiveTessellation(tess);
+        tess->tolerance = *tolerance;
+    }
+
+    // viewProjection already is projection * modelview
+    static const double IDENTITY[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    int cull = bounds && tolerance->screenSpace;
+    Frustum frustum;
+    if (cull) frustum = frustum_fromMatrices(tolerance->viewProjection, IDENTITY);
+
+    int rebuilt = 0;
+    for (int seg = 1; seg <= curve->numSegments; seg++) {
+        AdaptiveSegment* out = &tess->segments[seg - 1];
+        if (out->state == ADAPTIVE_SEGMENT_DONE) continue;
+
+        // Culled before any evaluation; a culled segment only needs its end point once
+        int visible = !cull || frustum_intersectsBox(&frustum, &bounds[seg - 1]);
+        if (!visible && out->state == ADAPTIVE_SEGMENT_CULLED) continue;
+
+        out->numVertices = 0;
+        Vec3 p1 = curve_position(curve, seg, 1.0f);
+        int ok = visible ? subdivide(out, curve, seg, tolerance, 0.0f, curve_position(curve, seg, 0.0f), 1.0f, p1, 0)
+                         : appendVertex(out, p1);
+        if (!ok) {
+            fprintf(stderr, "Error: Failed to allocate adaptive tessellation\n");
+            out->state = ADAPTIVE_SEGMENT_STALE;
+            tess->valid = 0;
+            return -1;
+        }
+        out->state = visible ? ADAPTIVE_SEGMENT_DONE : ADAPTIVE_SEGMENT_CULLED;
+        rebuilt++;
+    }
+
+    if (rebuilt == 0 && tess->valid) return 0;
+
+    if (!packStrip(tess, curve)) {
+        fprintf(stderr, "Error: Failed to allocate adaptive tessellation\n");
+        tess->valid = 0;
+        return -1;
+    }
+    tess->valid = 1;
+    return rebuilt;
+}
+
+void bspline_markAdaptiveSegments(AdaptiveTessellation* tess, const int* segments, int count) {
+    if (!tess || !tess->segments || !segments) return;
+
+    for (int i = 0; i < count; i++) {
+        if (segments[i] >= 1 && segments[i] <= tess->numSegments) {
+            tess->segments[segments[i] - 1].state = ADAPTIVE_SEGMENT_STALE;
+        }
+    }
+}
+
+void bspline_invalidateAdaptiveTessellation(AdaptiveTessellation* tess) {
+    if (!tess || !tess->segments) return;
+
+    for (int i = 0; i < tess->numSegments; i++) {
+        tess->segments[i].state = ADAPTIVE_SEGMENT_STALE;
+    }
+}
+
+void bspline_freeAdaptiveTessellation(AdaptiveTessellation* tess) {
+    if (!tess) return;
+    if (tess->vertices) free(tess->vertices);
+    if (tess->segmentFirst) free(tess->segmentFirst);
+    if (tess->segments) {
+        for (int i = 0; i < tess->numSegments; i++) free(tess->segments[i].vertices);
+        free(tess->segments);
+    }
+    bspline_initAdaptiveTessellation(tess);
+}
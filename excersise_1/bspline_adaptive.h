@@ -0,0 +1,143 @@
+#ifndef BSPLINE_ADAPTIVE_H
+#define BSPLINE_ADAPTIVE_H
+
+#include "curve_evaluator.h"
+#include "bspline_bounds.h"
+
+// ============================================================================
+// ADAPTIVE (ERROR-BOUNDED) TESSELLATION
+// Each segment is split at parameter midpoints until the chord between two
+// vertices stays within a tolerance of the curve. The deviation is measured
+// in world units or, with a view-projection matrix, in screen pixels.
+// Nearly straight segments become a single line, tight turns get refined.
+// Curves come in through CurveEvaluator, so compiled uniform curves and
+// NURBS curves tessellate the same way.
+// Results are cached per segment: edits re-tessellate only the segments
+// they touched, and with per-segment bounds, segments outside the view are
+// skipped until they come into view.
+// ============================================================================
+
+/**
+ * Error bound for adaptive tessellation
+ */
+typedef struct {
+    double tolerance;           // Max chord deviation (world units or pixels)
+    int screenSpace;            // 1: measure in pixels through viewProjection
+    double viewProjection[16];  // Column-major projection * modelview (screen space only)
+    double viewportWidth;       // Viewport size in pixels (screen space only)
+    double viewportHeight;
+} TessellationTolerance;
+
+/**
+ * Cache state of one segment
+ */
+typedef enum {
+    ADAPTIVE_SEGMENT_STALE = 0,   // Edited, new tolerance or view: rebuild when drawn
+    ADAPTIVE_SEGMENT_CULLED = 1,  // Outside the frustum: one chord to its end point
+    ADAPTIVE_SEGMENT_DONE = 2     // Subdivided within the tolerance
+} AdaptiveSegmentState;
+
+/**
+ * Cached vertices of one segment
+ */
+typedef struct {
+    float* vertices;   // 3 floats per vertex, t in (0, 1] (start is the previous end)
+    int numVertices;
+    int capacity;      // Allocated vertices
+    int state;         // AdaptiveSegmentState
+} AdaptiveSegment;
+
+/**
+ * Adaptively tessellated curve as one continuous line strip
+ *
+ * Segment i occupies vertices segmentFirst[i - 1] .. segmentFirst[i]
+ * (neighbours share their joint vertex). The strip is packed from the
+ * per-segment cache whenever a segment was rebuilt.
+ */
+typedef struct {
+    float* vertices;       // 3 floats per vertex
+    int numVertices;
+    int capacity;          // Allocated vertices
+    int* segmentFirst;     // numSegments + 1 vertex indices
+    int numSegments;
+    AdaptiveSegment* segments;        // Per-segment cache (index 0 = segment 1)
+
+    int valid;                        // Strip matches the per-segment cache
+    TessellationTolerance tolerance;  // Tolerance (and view) the cache was built with
+} AdaptiveTessellation;
+
+/**
+ * Initialize empty adaptive tessellation
+ *
+ * @param tess Tessellation to initialize
+ */
+void bspline_initAdaptiveTessellation(AdaptiveTessellation* tess);
+
+/**
+ * World-space tolerance
+ *
+ * @param tolerance Max chord deviation in world units
+ * @return Tolerance description
+ */
+TessellationTolerance bspline_worldTolerance(double tolerance);
+
+/**
+ * Screen-space tolerance
+ *
+ * @param pixels Max chord deviation in pixels
+ * @param projection Column-major projection matrix
+ * @param modelview Column-major modelview matrix
+ * @param viewportWidth Viewport width in pixels
+ * @param viewportHeight Viewport height in pixels
+ * @return Tolerance description
+ */
+TessellationTolerance bspline_screenTolerance(double pixels, const double* projection, const double* modelview,
+                                              double viewportWidth, double viewportHeight);
+
+/**
+ * Bring the tessellation up to date
+ *
+ * Only stale segments are subdivided; the others keep their cached
+ * vertices. A new tolerance makes every segment stale. In screen space the
+ * view matrices are part of the tolerance, so a camera move rebuilds the
+ * visible segments; in world space it does not. Edits are reported with
+ * bspline_markAdaptiveSegments (bspline_updateEditable does this for an
+ * attached tessellation).
+ *
+ * With bounds and a screen-space tolerance, segments outside the view
+ * frustum are not subdivided; they hold a single chord that the culled
+ * draw never shows, and are rebuilt once they come into view.
+ *
+ * @param tess Tessellation (initialized with bspline_initAdaptiveTessellation)
+ * @param curve Curve to tessellate (e.g. curve_fromCompiled or curve_fromNurbs)
+ * @param bounds Per-segment bounds (index 0 = segment 1), or NULL to tessellate everything
+ * @param tolerance Error bound
+ * @return Number of segments rebuilt (0 if the cache was kept), -1 on error
+ */
+int bspline_updateAdaptiveTessellation(AdaptiveTessellation* tess, const CurveEvaluator* curve,
+                                       const AABB* bounds, const TessellationTolerance* tolerance);
+
+/**
+ * Mark segments stale after their control points moved
+ *
+ * @param tess Tessellation
+ * @param segments Segment indices (1 to numSegments)
+ * @param count Number of segments
+ */
+void bspline_markAdaptiveSegments(AdaptiveTessellation* tess, const int* segments, int count);
+
+/**
+ * Force the next update to rebuild every segment
+ *
+ * @param tess Tessellation
+ */
+void bspline_invalidateAdaptiveTessellation(AdaptiveTessellation* tess);
+
+/**
+ * Release tessellation memory
+ *
+ * @param tess Tessellation to free
+ */
+void bspline_freeAdaptiveTessellation(AdaptiveTessellation* tess);
+
+#endif // BSPLINE_ADAPTIVE_H
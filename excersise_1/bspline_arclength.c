@@ -0,0 +1,241 @@
+#include "bspline_arclength.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// 5-point Gauss-Legendre nodes and weights on [-1, 1]
+static const double GL_NODES[5] = {
+    -0.9061798459386640, -0.5384693101056831, 0.0, 0.5384693101056831, 0.9061798459386640
+};
+static const double GL_WEIGHTS[5] = {
+    0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891
+};
+
+// Newton iterations per lookup (quadratic convergence - 3 is plenty)
+#define NEWTON_ITERATIONS 3
+
+// Cursor walks further than this fall back to binary search
+#define CURSOR_MAX_WALK 8
+
+// ============================================================================
+// QUADRATURE
+// ============================================================================
+
+/**
+ * Speed |p'(t)| of a compiled segment (double parameter)
+ */
+static double segmentSpeed(const BSplineSegmentPoly* poly, double t) {
+    const Vec3* k = poly->d1;
+    double x = (k[0].x * t + k[1].x) * t + k[2].x;
+    double y = (k[0].y * t + k[1].y) * t + k[2].y;
+    double z = (k[0].z * t + k[1].z) * t + k[2].z;
+    return sqrt(x * x + y * y + z * z);
+}
+
+static double integrateSpeed(const BSplineSegmentPoly* poly, double t0, double t1) {
+    double half = 0.5 * (t1 - t0);
+    double mid = 0.5 * (t1 + t0);
+    double sum = 0.0;
+    for (int i = 0; i < 5; i++) {
+        sum += GL_WEIGHTS[i] * segmentSpeed(poly, mid + half * GL_NODES[i]);
+    }
+    return sum * half;
+}
+
+double bspline_segmentArcLength(const BSplineCurve* curve, int segment, double t0, double t1) {
+    if (!curve || segment < 1 || segment > curve->numSegments) return 0.0;
+    return integrateSpeed(&curve->segments[segment - 1], t0, t1);
+}
+
+// ============================================================================
+// TABLE CONSTRUCTION
+// ============================================================================
+
+ArcLengthTable* bspline_buildArcLengthTable(const BSplineCurve* curve, int subdivisions) {
+    if (!curve || curve->numSegments <= 0 || subdivisions < 1) {
+        fprintf(stderr, "Error: Invalid curve for arc-length table\n");
+        return NULL;
+    }
+
+    ArcLengthTable* table = (ArcLengthTable*)malloc(sizeof(ArcLengthTable));
+    if (!table) return NULL;
+
+    table->numEntries = curve->numSegments * subdivisions + 1;
+    table->cumulative = (double*)malloc(table->numEntries * sizeof(double));
+    if (!table->cumulative) {
+        free(table);
+        return NULL;
+    }
+    table->curve = curve;
+    table->subdivisions = subdivisions;
+
+    double h = 1.0 / subdivisions;
+    double s = 0.0;
+    int k = 0;
+    table->cumulative[k++] = 0.0;
+    for (int seg = 0; seg < curve->numSegments; seg++) {
+        for (int j = 0; j < subdivisions; j++) {
+            s += integrateSpeed(&curve->segments[seg], j * h, (j + 1) * h);
+            table->cumulative[k++] = s;
+        }
+    }
+    table->totalLength = s;
+
+    return table;
+}
+
+void bspline_freeArcLengthTable(ArcLengthTable* table) {
+    if (table) {
+        if (table->cumulative) free(table->cumulative);
+        free(table);
+    }
+}
+
+void bspline_updateArcLengthSegments(ArcLengthTable* table, const int* segments, int count) {
+    if (!table || !segments || count <= 0) return;
+
+    int sub = table->subdivisions;
+    double h = 1.0 / sub;
+    double shift = 0.0;  // New minus old length of everything processed so far
+    int done = 0;        // Entries [0, done] hold final values
+
+    for (int i = 0; i < count; i++) {
+        int k0 = (segments[i] - 1) * sub;
+
+        // Clean entries between the previous changed segment and this one
+        for (int k = done + 1; k <= k0; k++) {
+            table->cumulative[k] += shift;
+        }
+
+        double oldEnd = table->cumulative[k0 + sub];
+        double s = table->cumulative[k0];
+        const BSplineSegmentPoly* poly = &table->curve->segments[segments[i] - 1];
+        for (int j = 0; j < sub; j++) {
+            s += integrateSpeed(poly, j * h, (j + 1) * h);
+            table->cumulative[k0 + j + 1] = s;
+        }
+        shift = s - oldEnd;
+        done = k0 + sub;
+    }
+
+    if (shift != 0.0) {
+        for (int k = done + 1; k < table->numEntries; k++) {
+            table->cumulative[k] += shift;
+        }
+    }
+    table->totalLength = table->cumulative[table->numEntries - 1];
+}
+
+// ============================================================================
+// LOOKUP
+// ============================================================================
+
+/**
+ * Find interval k with cumulative[k] <= distance < cumulative[k + 1]
+ */
+static int findInterval(const ArcLengthTable* table, double distance) {
+    int lo = 0;
+    int hi = table->numEntries - 1;  // Last interval is [hi - 1, hi]
+    while (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+        if (table->cumulative[mid] <= distance) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Newton refinement inside table interval k
+ *
+ * Solves L(t) = distance - cumulative[k] where L(t) is the length from the
+ * interval start; L'(t) = |p'(t)|. The iterate is kept inside the interval.
+ */
+static void solveInInterval(const ArcLengthTable* table, int k, double distance,
+                            int* outSegment, float* outT) {
+    int segIndex = k / table->subdivisions;
+    double h = 1.0 / table->subdivisions;
+    double t0 = (k % table->subdivisions) * h;
+    double t1 = t0 + h;
+    const BSplineSegmentPoly* poly = &table->curve->segments[segIndex];
+
+    double target = distance - table->cumulative[k];
+    double span = table->cumulative[k + 1] - table->cumulative[k];
+
+    // Initial guess: linear interpolation inside the interval
+    double t = (span > 1e-12) ? t0 + h * (target / span) : t0;
+
+    for (int i = 0; i < NEWTON_ITERATIONS; i++) {
+        double speed = segmentSpeed(poly, t);
+        if (speed < 1e-12) break;
+
+        t -= (integrateSpeed(poly, t0, t) - target) / speed;
+        if (t < t0) t = t0;
+        if (t > t1) t = t1;
+    }
+
+    *outSegment = segIndex + 1;
+    *outT = (float)t;
+}
+
+static double clampDistance(const ArcLengthTable* table, double distance) {
+    if (distance < 0.0) return 0.0;
+    if (distance > table->totalLength) return table->totalLength;
+    return distance;
+}
+
+void bspline_arcLengthToParameter(const ArcLengthTable* table, double distance,
+                                  int* outSegment, float* outT) {
+    if (!table || !outSegment || !outT) return;
+
+    distance = clampDistance(table, distance);
+    solveInInterval(table, findInterval(table, distance), distance, outSegment, outT);
+}
+
+void bspline_arcLengthToParameterHinted(const ArcLengthTable* table, double distance,
+                                        ArcLengthCursor* cursor, int* outSegment, float* outT) {
+    if (!table || !cursor || !outSegment || !outT) return;
+
+    distance = clampDistance(table, distance);
+
+    int last = table->numEntries - 2;  // Last valid interval
+    int k = cursor->index;
+    if (k < 0) k = 0;
+    if (k > last) k = last;
+
+    int steps = 0;
+    while (k < last && table->cumulative[k + 1] <= distance && steps < CURSOR_MAX_WALK) {
+        k++;
+        steps++;
+    }
+    while (k > 0 && table->cumulative[k] > distance && steps < CURSOR_MAX_WALK) {
+        k--;
+        steps++;
+    }
+
+    // Still not bracketed - query jumped far from the cursor
+    int bracketed = table->cumulative[k] <= distance &&
+                    (k == last || distance < table->cumulative[k + 1]);
+    if (!bracketed) {
+        k = findInterval(table, distance);
+    }
+
+    cursor->index = k;
+    solveInInterval(table, k, distance, outSegment, outT);
+}
+
+double bspline_parameterToArcLength(const ArcLengthTable* table, int segment, float t) {
+    if (!table || segment < 1 || segment > table->curve->numSegments) return 0.0;
+
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+
+    int j = (int)(t * table->subdivisions);
+    if (j >= table->subdivisions) j = table->subdivisions - 1;
+
+    int k = (segment - 1) * table->subdivisions + j;
+    double t0 = (double)j / table->subdivisions;
+    return table->cumulative[k] + integrateSpeed(&table->curve->segments[segment - 1], t0, t);
+}
@@ -0,0 +1,118 @@
+#ifndef BSPLINE_ARCLENGTH_H
+#define BSPLINE_ARCLENGTH_H
+
+#include "bspline_curve.h"
+
+// ============================================================================
+// ARC-LENGTH REPARAMETERIZATION
+// Maps distance travelled along the curve to (segment, t), so objects can
+// move at constant speed regardless of segment length and curvature.
+// ============================================================================
+
+/**
+ * Cumulative arc-length table
+ *
+ * Every segment is split into `subdivisions` equal parameter intervals.
+ * Entry k holds the curve length from the start of segment 1 up to
+ * segment k / subdivisions + 1, t = (k % subdivisions) / subdivisions.
+ */
+typedef struct {
+    const BSplineCurve* curve;  // Curve the table was built for (not owned)
+    double* cumulative;         // numEntries lengths, cumulative[0] = 0
+    int numEntries;             // numSegments * subdivisions + 1
+    int subdivisions;           // Parameter intervals per segment
+    double totalLength;         // Length of the whole curve
+} ArcLengthTable;
+
+/**
+ * Lookup hint for monotonically moving queries
+ *
+ * Holds the table interval of the previous lookup; nearby queries walk
+ * from there in O(1) instead of binary searching the whole table.
+ */
+typedef struct {
+    int index;  // Table interval [index, index + 1] of the last lookup
+} ArcLengthCursor;
+
+/**
+ * Length of a segment piece using 5-point Gauss-Legendre quadrature
+ *
+ * @param curve Compiled curve
+ * @param segment Segment index (1 to n-3)
+ * @param t0 Start parameter
+ * @param t1 End parameter
+ * @return Arc length between t0 and t1
+ */
+double bspline_segmentArcLength(const BSplineCurve* curve, int segment, double t0, double t1);
+
+/**
+ * Build cumulative arc-length table
+ *
+ * @param curve Compiled curve (must outlive the table)
+ * @param subdivisions Parameter intervals per segment (e.g. 8)
+ * @return Newly allocated table (free with bspline_freeArcLengthTable), or NULL on error
+ */
+ArcLengthTable* bspline_buildArcLengthTable(const BSplineCurve* curve, int subdivisions);
+
+/**
+ * Free arc-length table
+ *
+ * @param table Table to free (NULL is allowed)
+ */
+void bspline_freeArcLengthTable(ArcLengthTable* table);
+
+/**
+ * Refresh table after some segments of its curve were recompiled
+ *
+ * Only the listed segments are integrated again. Entries after a changed
+ * segment are shifted by its length difference in one pass.
+ *
+ * @param table Arc-length table of the (recompiled) curve
+ * @param segments Changed segment indices (1 to n-3), ascending, no duplicates
+ * @param count Number of changed segments
+ */
+void bspline_updateArcLengthSegments(ArcLengthTable* table, const int* segments, int count);
+
+/**
+ * Map distance along the curve to (segment, t)
+ *
+ * Binary search over the table followed by Newton refinement of
+ * s(t) - distance = 0 inside the found interval. O(log n).
+ *
+ * @param table Arc-length table
+ * @param distance Distance from curve start (clamped to [0, totalLength])
+ * @param outSegment Output segment index (1 to n-3)
+ * @param outT Output parameter in [0, 1]
+ */
+void bspline_arcLengthToParameter(const ArcLengthTable* table, double distance,
+                                  int* outSegment, float* outT);
+
+/**
+ * Map distance to (segment, t) starting from a cursor
+ *
+ * Same result as bspline_arcLengthToParameter. The search walks from the
+ * cursor's interval, so steadily advancing agents pay O(1) per lookup;
+ * large jumps fall back to binary search. The cursor is updated.
+ *
+ * @param table Arc-length table
+ * @param distance Distance from curve start (clamped to [0, totalLength])
+ * @param cursor Lookup hint (initialize index to 0)
+ * @param outSegment Output segment index (1 to n-3)
+ * @param outT Output parameter in [0, 1]
+ */
+void bspline_arcLengthToParameterHinted(const ArcLengthTable* table, double distance,
+                                        ArcLengthCursor* cursor, int* outSegment, float* outT);
+
+/**
+ * Distance from curve start to (segment, t)
+ *
+ * Inverse of bspline_arcLengthToParameter.
+ *
+ * @param table Arc-length table
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1]
+ * @return Distance along the curve
+ */
+double bspline_parameterToArcLength(const ArcLengthTable* table, int segment, float t);
+
+#endif // BSPLINE_ARCLENGTH_H
@@ -0,0 +1,110 @@
+#include "bspline_bake.h"
+#include "bspline_curve.h"
+#include <stddef.h>
+
+// Shared, read-only description of one bake job
+typedef struct {
+    const Vec3* controlPoints;
+    int numSegments;
+    int samplesPerSegment;
+    float* outPositions;
+    float* outTangents;
+} BakeJob;
+
+// ============================================================================
+// PER-SEGMENT SAMPLING
+// ============================================================================
+
+/**
+ * Sample segment at t = 0, h, ..., count * h - h (Horner on the power form)
+ */
+static void sampleSegment(const Vec3* r, double h, int count, float* pos, float* tan) {
+    Vec3 coeff[4];
+    bspline_segmentPowerForm(r, coeff);
+    double a[3] = {coeff[0].x, coeff[0].y, coeff[0].z};
+    double b[3] = {coeff[1].x, coeff[1].y, coeff[1].z};
+    double c[3] = {coeff[2].x, coeff[2].y, coeff[2].z};
+    double d[3] = {coeff[3].x, coeff[3].y, coeff[3].z};
+
+    for (int i = 0; i < count; i++) {
+        double t = i * h;
+        for (int k = 0; k < 3; k++) {
+            pos[3 * i + k] = (float)(((a[k] * t + b[k]) * t + c[k]) * t + d[k]);
+        }
+        if (tan) {
+            for (int k = 0; k < 3; k++) {
+                tan[3 * i + k] = (float)((3.0 * a[k] * t + 2.0 * b[k]) * t + c[k]);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// WORKER
+// ============================================================================
+
+/**
+ * Worker w bakes the contiguous segment range [w * N / W, (w + 1) * N / W)
+ *
+ * Contiguous ranges keep each worker streaming through its own part of
+ * the control points and of the output buffer.
+ */
+static void bakeTask(void* context, int worker, int numWorkers) {
+    const BakeJob* job = (const BakeJob*)context;
+
+    long first = (long)job->numSegments * worker / numWorkers;
+    long last = (long)job->numSegments * (worker + 1) / numWorkers;
+
+    int perSegment = job->samplesPerSegment - 1;
+    double h = 1.0 / perSegment;
+
+    for (long seg = first; seg < last; seg++) {
+        size_t offset = (size_t)seg * perSegment * 3;
+        sampleSegment(job->controlPoints + seg, h, perSegment,
+                      job->outPositions + offset,
+                      job->outTangents ? job->outTangents + offset : NULL);
+    }
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+long bspline_bakeVertexCount(int numControlPoints, int samplesPerSegment) {
+    int numSegments = bspline_getNumSegments(numControlPoints);
+    if (numSegments <= 0 || samplesPerSegment < 2) return 0;
+    return (long)numSegments * (samplesPerSegment - 1) + 1;
+}
+
+long bspline_bakePath(const Vec3* controlPoints, int numControlPoints, int samplesPerSegment,
+                      ThreadPool* pool, float* outPositions, float* outTangents) {
+    long numVertices = bspline_bakeVertexCount(numControlPoints, samplesPerSegment);
+    if (!controlPoints || !outPositions || numVertices == 0) return 0;
+
+    BakeJob job = {
+        controlPoints,
+        bspline_getNumSegments(numControlPoints),
+        samplesPerSegment,
+        outPositions,
+        outTangents
+    };
+
+    if (pool) {
+        threadpool_run(pool, bakeTask, &job);
+    } else {
+        bakeTask(&job, 0, 1);
+    }
+
+    // Curve end point p_last(1) - the only vertex no segment slice owns.
+    // Samples t = 0 and t = 1 (step 1) of the last segment; keep the second.
+    float endPos[6], endTan[6];
+    sampleSegment(controlPoints + job.numSegments - 1, 1.0, 2, endPos, endTan);
+
+    size_t last = (size_t)(numVertices - 1) * 3;
+    for (int k = 0; k < 3; k++) {
+        outPositions[last + k] = endPos[3 + k];
+        if (outTangents) outTangents[last + k] = endTan[3 + k];
+    }
+
+    return numVertices;
+}
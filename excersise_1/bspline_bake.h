@@ -0,0 +1,45 @@
+#ifndef BSPLINE_BAKE_H
+#define BSPLINE_BAKE_H
+
+#include "bspline.h"
+#include "thread_pool.h"
+
+// ============================================================================
+// MULTITHREADED BULK PATH BAKING
+// Samples very large control polygons by splitting the segments across a
+// thread pool. Every worker writes a disjoint slice of one preallocated
+// buffer, and every vertex is computed by the same code regardless of the
+// slice it falls in, so output is bit-identical for any thread count.
+// ============================================================================
+
+/**
+ * Number of vertices produced by bspline_bakePath
+ *
+ * Segment i owns samples t = 0, h, ..., 1 - h (h = 1 / (samplesPerSegment - 1));
+ * the final curve end point is appended once:
+ *   numSegments * (samplesPerSegment - 1) + 1
+ *
+ * @param numControlPoints Number of control points
+ * @param samplesPerSegment Samples per segment including both ends (>= 2)
+ * @return Vertex count (0 if the curve is empty)
+ */
+long bspline_bakeVertexCount(int numControlPoints, int samplesPerSegment);
+
+/**
+ * Sample whole curve into preallocated buffers using a thread pool
+ *
+ * Works directly on the control points (no compiled curve needed), so the
+ * only large allocation is the output itself.
+ *
+ * @param controlPoints Array of control points
+ * @param numControlPoints Number of control points (at least 4)
+ * @param samplesPerSegment Samples per segment including both ends (>= 2)
+ * @param pool Thread pool (NULL runs single-threaded)
+ * @param outPositions Output xyz floats, 3 * bspline_bakeVertexCount(...) entries
+ * @param outTangents Optional output xyz tangents (same size), or NULL
+ * @return Number of vertices written (0 on error)
+ */
+long bspline_bakePath(const Vec3* controlPoints, int numControlPoints, int samplesPerSegment,
+                      ThreadPool* pool, float* outPositions, float* outTangents);
+
+#endif // BSPLINE_BAKE_H
@@ -0,0 +1,177 @@
+#include "bspline_batch.h"
+#include "bspline_curve.h"
+#include "simd_dispatch.h"
+#include <pthread.h>
+
+// ============================================================================
+// SEGMENT POWER FORM
+// ============================================================================
+
+/**
+ * Power form of segment i (bspline_segmentPowerForm) rounded to float
+ *
+ * @param controlPoints Array of control points
+ * @param segment Segment index (1 to n-3)
+ * @param poly Output coefficients, poly[component][0..3] = {a, b, c, d}
+ */
+static void computeSegmentPolynomial(const Vec3* controlPoints, int segment, float poly[3][4]) {
+    Vec3 coeff[4];
+    bspline_segmentPowerForm(controlPoints + (segment - 1), coeff);
+
+    for (int j = 0; j < 4; j++) {
+        poly[0][j] = (float)coeff[j].x;
+        poly[1][j] = (float)coeff[j].y;
+        poly[2][j] = (float)coeff[j].z;
+    }
+}
+
+// ============================================================================
+// HORNER KERNELS
+// Evaluate three cubics (x, y, z) over the same parameter array in one pass.
+// The scalar kernel also finishes the tails the vector kernels leave over.
+// ============================================================================
+
+static void evaluateCubic3_scalar(const float poly[3][4], const float* ts, int begin, int count,
+                                  float* outX, float* outY, float* outZ) {
+    for (int i = begin; i < count; i++) {
+        float t = ts[i];
+        outX[i] = ((poly[0][0] * t + poly[0][1]) * t + poly[0][2]) * t + poly[0][3];
+        outY[i] = ((poly[1][0] * t + poly[1][1]) * t + poly[1][2]) * t + poly[1][3];
+        outZ[i] = ((poly[2][0] * t + poly[2][1]) * t + poly[2][2]) * t + poly[2][3];
+    }
+}
+
+#if defined(SIMD_X86)
+
+static SIMD_TARGET("avx2,fma")
+void evaluateCubic3_avx2(const float poly[3][4], const float* ts, int begin, int count,
+                         float* outX, float* outY, float* outZ) {
+    __m256 k[3][4];
+    for (int c = 0; c < 3; c++) {
+        for (int j = 0; j < 4; j++) {
+            k[c][j] = _mm256_set1_ps(poly[c][j]);
+        }
+    }
+
+    int i = begin;
+    for (; i + 8 <= count; i += 8) {
+        __m256 t = _mm256_loadu_ps(ts + i);
+        __m256 x = _mm256_fmadd_ps(_mm256_fmadd_ps(_mm256_fmadd_ps(k[0][0], t, k[0][1]), t, k[0][2]), t, k[0][3]);
+        __m256 y = _mm256_fmadd_ps(_mm256_fmadd_ps(_mm256_fmadd_ps(k[1][0], t, k[1][1]), t, k[1][2]), t, k[1][3]);
+        __m256 z = _mm256_fmadd_ps(_mm256_fmadd_ps(_mm256_fmadd_ps(k[2][0], t, k[2][1]), t, k[2][2]), t, k[2][3]);
+        _mm256_storeu_ps(outX + i, x);
+        _mm256_storeu_ps(outY + i, y);
+        _mm256_storeu_ps(outZ + i, z);
+    }
+
+    evaluateCubic3_scalar(poly, ts, i, count, outX, outY, outZ);
+}
+
+static inline SIMD_TARGET("sse2")
+__m128 horner4(__m128 a, __m128 b, __m128 c, __m128 d, __m128 t) {
+    return _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(a, t), b), t), c), t), d);
+}
+
+static SIMD_TARGET("sse2")
+void evaluateCubic3_sse2(const float poly[3][4], const float* ts, int begin, int count,
+                         float* outX, float* outY, float* outZ) {
+    __m128 k[3][4];
+    for (int c = 0; c < 3; c++) {
+        for (int j = 0; j < 4; j++) {
+            k[c][j] = _mm_set1_ps(poly[c][j]);
+        }
+    }
+
+    int i = begin;
+    for (; i + 4 <= count; i += 4) {
+        __m128 t = _mm_loadu_ps(ts + i);
+        _mm_storeu_ps(outX + i, horner4(k[0][0], k[0][1], k[0][2], k[0][3], t));
+        _mm_storeu_ps(outY + i, horner4(k[1][0], k[1][1], k[1][2], k[1][3], t));
+        _mm_storeu_ps(outZ + i, horner4(k[2][0], k[2][1], k[2][2], k[2][3], t));
+    }
+
+    evaluateCubic3_scalar(poly, ts, i, count, outX, outY, outZ);
+}
+
+#endif
+
+// ============================================================================
+// DISPATCH
+// ============================================================================
+
+typedef void (*CubicKernel)(const float poly[3][4], const float* ts, int begin, int count,
+                            float* outX, float* outY, float* outZ);
+
+static pthread_once_t dispatchOnce = PTHREAD_ONCE_INIT;
+static CubicKernel currentKernel = evaluateCubic3_scalar;
+static const char* currentKernelName = "scalar";
+
+static void initDispatch(void) {
+#if defined(SIMD_X86)
+    SimdLevel level = simd_cpuLevel();
+    if (level >= SIMD_LEVEL_AVX2_FMA) {
+        currentKernel = evaluateCubic3_avx2;
+        currentKernelName = "AVX2+FMA";
+    } else if (level >= SIMD_LEVEL_SSE2) {
+        currentKernel = evaluateCubic3_sse2;
+        currentKernelName = "SSE2";
+    }
+#endif
+}
+
+static CubicKernel cubicKernel(void) {
+    pthread_once(&dispatchOnce, initDispatch);
+    return currentKernel;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void bspline_evaluatePositionBatch(const Vec3* controlPoints, int segment,
+                                   const float* ts, int count,
+                                   float* outX, float* outY, float* outZ) {
+    if (!controlPoints || !ts || count <= 0) return;
+
+    float poly[3][4];
+    computeSegmentPolynomial(controlPoints, segment, poly);
+    cubicKernel()(poly, ts, 0, count, outX, outY, outZ);
+}
+
+void bspline_evaluateTangentBatch(const Vec3* controlPoints, int segment,
+                                  const float* ts, int count,
+                                  float* outX, float* outY, float* outZ) {
+    if (!controlPoints || !ts || count <= 0) return;
+
+    float poly[3][4];
+    computeSegmentPolynomial(controlPoints, segment, poly);
+
+    // p'(t) = 3a t^2 + 2b t + c, written as a cubic with zero leading term
+    float deriv[3][4];
+    for (int c = 0; c < 3; c++) {
+        deriv[c][0] = 0.0f;
+        deriv[c][1] = 3.0f * poly[c][0];
+        deriv[c][2] = 2.0f * poly[c][1];
+        deriv[c][3] = poly[c][2];
+    }
+    cubicKernel()(deriv, ts, 0, count, outX, outY, outZ);
+}
+
+void bspline_uniformParameters(float* ts, int count) {
+    if (!ts || count <= 0) return;
+    if (count == 1) {
+        ts[0] = 0.0f;
+        return;
+    }
+
+    float step = 1.0f / (float)(count - 1);
+    for (int i = 0; i < count; i++) {
+        ts[i] = (float)i * step;
+    }
+    ts[count - 1] = 1.0f;  // Hit the segment end exactly
+}
+
+const char* bspline_batchKernelName(void) {
+    cubicKernel();
+    return currentKernelName;
+}
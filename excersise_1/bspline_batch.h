@@ -0,0 +1,65 @@
+#ifndef BSPLINE_BATCH_H
+#define BSPLINE_BATCH_H
+
+#include "bspline.h"
+
+// ============================================================================
+// BATCHED B-SPLINE EVALUATION
+// Evaluates many parameters on one segment per call (SoA float output).
+// Kernels: AVX2+FMA, SSE2 or scalar, picked at run time (simd_dispatch.h).
+// ============================================================================
+
+/**
+ * Evaluate positions on segment for an array of parameters
+ *
+ * Same result as calling bspline_evaluatePosition for every ts[i], but the
+ * segment is converted to power form once and each sample is evaluated
+ * with Horner's rule: p(t) = ((a*t + b)*t + c)*t + d.
+ *
+ * @param controlPoints Array of control points
+ * @param segment Segment index (1 to n-3)
+ * @param ts Array of parameters in [0, 1]
+ * @param count Number of parameters
+ * @param outX Output x coordinates (count floats)
+ * @param outY Output y coordinates (count floats)
+ * @param outZ Output z coordinates (count floats)
+ */
+void bspline_evaluatePositionBatch(const Vec3* controlPoints, int segment,
+                                   const float* ts, int count,
+                                   float* outX, float* outY, float* outZ);
+
+/**
+ * Evaluate tangents (equation 1.3) on segment for an array of parameters
+ *
+ * Batched counterpart of bspline_evaluateTangent (unnormalized vectors).
+ *
+ * @param controlPoints Array of control points
+ * @param segment Segment index (1 to n-3)
+ * @param ts Array of parameters in [0, 1]
+ * @param count Number of parameters
+ * @param outX Output x components (count floats)
+ * @param outY Output y components (count floats)
+ * @param outZ Output z components (count floats)
+ */
+void bspline_evaluateTangentBatch(const Vec3* controlPoints, int segment,
+                                  const float* ts, int count,
+                                  float* outX, float* outY, float* outZ);
+
+/**
+ * Fill parameter array with uniform samples t_i = i / (count - 1)
+ *
+ * Convenience helper for sampling a whole segment including both ends.
+ *
+ * @param ts Output array of parameters
+ * @param count Number of samples (count == 1 gives t = 0)
+ */
+void bspline_uniformParameters(float* ts, int count);
+
+/**
+ * Name of the kernel the batch functions run on this CPU
+ *
+ * @return "AVX2+FMA", "SSE2" or "scalar"
+ */
+const char* bspline_batchKernelName(void);
+
+#endif // BSPLINE_BATCH_H
@@ -0,0 +1,39 @@
+#include "bspline_bounds.h"
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+AABB bspline_segmentBounds(const Vec3* controlPoints, int segment) {
+    const Vec3* r = &controlPoints[segment - 1];
+    AABB box = {r[0], r[0]};
+
+    for (int k = 1; k < 4; k++) {
+        if (r[k].x < box.min.x) box.min.x = r[k].x;
+        if (r[k].y < box.min.y) box.min.y = r[k].y;
+        if (r[k].z < box.min.z) box.min.z = r[k].z;
+        if (r[k].x > box.max.x) box.max.x = r[k].x;
+        if (r[k].y > box.max.y) box.max.y = r[k].y;
+        if (r[k].z > box.max.z) box.max.z = r[k].z;
+    }
+    return box;
+}
+
+int bspline_computeSegmentBounds(const Vec3* controlPoints, int numControlPoints, AABB* outBounds) {
+    int numSegments = bspline_getNumSegments(numControlPoints);
+    for (int seg = 1; seg <= numSegments; seg++) {
+        outBounds[seg - 1] = bspline_segmentBounds(controlPoints, seg);
+    }
+    return numSegments > 0 ? numSegments : 0;
+}
+
+AABB bspline_mergeBounds(AABB a, AABB b) {
+    AABB box = a;
+    if (b.min.x < box.min.x) box.min.x = b.min.x;
+    if (b.min.y < box.min.y) box.min.y = b.min.y;
+    if (b.min.z < box.min.z) box.min.z = b.min.z;
+    if (b.max.x > box.max.x) box.max.x = b.max.x;
+    if (b.max.y > box.max.y) box.max.y = b.max.y;
+    if (b.max.z > box.max.z) box.max.z = b.max.z;
+    return box;
+}
@@ -0,0 +1,48 @@
+#ifndef BSPLINE_BOUNDS_H
+#define BSPLINE_BOUNDS_H
+
+#include "bspline.h"
+
+// ============================================================================
+// SEGMENT BOUNDS
+// A uniform B-spline segment lies inside the convex hull of its four
+// control points, so their axis-aligned box bounds the whole segment.
+// ============================================================================
+
+/**
+ * Axis-aligned bounding box
+ */
+typedef struct {
+    Vec3 min;
+    Vec3 max;
+} AABB;
+
+/**
+ * Bounds of one segment's control hull
+ *
+ * @param controlPoints Array of control points
+ * @param segment Segment index (1 to n-3)
+ * @return Box containing control points r_{i-1} .. r_{i+2}
+ */
+AABB bspline_segmentBounds(const Vec3* controlPoints, int segment);
+
+/**
+ * Bounds of every segment
+ *
+ * @param controlPoints Array of control points
+ * @param numControlPoints Number of control points (at least 4)
+ * @param outBounds Output array with numControlPoints - 3 entries (index 0 = segment 1)
+ * @return Number of boxes written
+ */
+int bspline_computeSegmentBounds(const Vec3* controlPoints, int numControlPoints, AABB* outBounds);
+
+/**
+ * Smallest box containing both boxes
+ *
+ * @param a First box
+ * @param b Second box
+ * @return Union of a and b
+ */
+AABB bspline_mergeBounds(AABB a, AABB b);
+
+#endif // BSPLINE_BOUNDS_H
@@ -0,0 +1,419 @@
+#include "bspline_bvh.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Segments per leaf
+#define BVH_LEAF_SEGMENTS 2
+
+// Traversal stack depth (median splits keep depth near log2(numSegments))
+#define BVH_STACK_SIZE 64
+
+// Sign-change search intervals and Newton iterations of the local solver
+#define SOLVER_INTERVALS 8
+#define SOLVER_ITERATIONS 12
+
+// ============================================================================
+// LOCAL SOLVER
+// ============================================================================
+
+static Vec3 polyPosition(const BSplineSegmentPoly* poly, double t) {
+    const Vec3* k = poly->pos;
+    return (Vec3){
+        ((k[0].x * t + k[1].x) * t + k[2].x) * t + k[3].x,
+        ((k[0].y * t + k[1].y) * t + k[2].y) * t + k[3].y,
+        ((k[0].z * t + k[1].z) * t + k[2].z) * t + k[3].z
+    };
+}
+
+static Vec3 polyTangent(const BSplineSegmentPoly* poly, double t) {
+    const Vec3* k = poly->d1;
+    return (Vec3){
+        (k[0].x * t + k[1].x) * t + k[2].x,
+        (k[0].y * t + k[1].y) * t + k[2].y,
+        (k[0].z * t + k[1].z) * t + k[2].z
+    };
+}
+
+static Vec3 polySecondDerivative(const BSplineSegmentPoly* poly, double t) {
+    const Vec3* k = poly->d2;
+    return (Vec3){k[0].x * t + k[1].x, k[0].y * t + k[1].y, k[0].z * t + k[1].z};
+}
+
+/**
+ * g(t) = p'(t) . (p(t) - q), half the derivative of |p(t) - q|^2
+ */
+static double distanceSlope(const BSplineSegmentPoly* poly, Vec3 q, double t) {
+    Vec3 p = polyPosition(poly, t);
+    Vec3 d = polyTangent(poly, t);
+    return d.x * (p.x - q.x) + d.y * (p.y - q.y) + d.z * (p.z - q.z);
+}
+
+static double distanceSquared(const BSplineSegmentPoly* poly, Vec3 q, double t) {
+    Vec3 p = polyPosition(poly, t);
+    double dx = p.x - q.x, dy = p.y - q.y, dz = p.z - q.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * Root of g inside [lo, hi] where g(lo) < 0 < g(hi)
+ *
+ * Newton steps with g'(t) = p'' . (p - q) + |p'|^2; any step leaving the
+ * bracket (or a non-positive g') is replaced by bisection.
+ */
+static double solveBracket(const BSplineSegmentPoly* poly, Vec3 q, double lo, double hi) {
+    double t = 0.5 * (lo + hi);
+
+    for (int iter = 0; iter < SOLVER_ITERATIONS; iter++) {
+        Vec3 p = polyPosition(poly, t);
+        Vec3 d = polyTangent(poly, t);
+        Vec3 dd = polySecondDerivative(poly, t);
+        Vec3 r = {p.x - q.x, p.y - q.y, p.z - q.z};
+
+        double g = d.x * r.x + d.y * r.y + d.z * r.z;
+        double dg = dd.x * r.x + dd.y * r.y + dd.z * r.z + d.x * d.x + d.y * d.y + d.z * d.z;
+
+        if (g < 0.0) lo = t; else hi = t;
+
+        double next = (dg > 0.0) ? t - g / dg : lo - 1.0;
+        if (next <= lo || next >= hi) next = 0.5 * (lo + hi);
+
+        if (fabs(next - t) < 1e-12) return next;
+        t = next;
+    }
+    return t;
+}
+
+static double solveSegment(const BSplineSegmentPoly* poly, Vec3 q, double* outDist2) {
+    double h = 1.0 / SOLVER_INTERVALS;
+    double bestT = 0.0;
+    double best = distanceSquared(poly, q, 0.0);
+
+    double end = distanceSquared(poly, q, 1.0);
+    if (end < best) {
+        best = end;
+        bestT = 1.0;
+    }
+
+    // Interior minima: g changes sign from - to + between samples, or is
+    // exactly 0 at a sample (e.g. t = 0.5 on a symmetric segment)
+    double gPrev = distanceSlope(poly, q, 0.0);
+    for (int i = 1; i <= SOLVER_INTERVALS; i++) {
+        double t1 = i * h;
+        double g = distanceSlope(poly, q, t1);
+        double t = -1.0;
+        if (g == 0.0) {
+            t = t1;
+        } else if (gPrev < 0.0 && g > 0.0) {
+            t = solveBracket(poly, q, t1 - h, t1);
+        }
+        if (t >= 0.0) {
+            double d2 = distanceSquared(poly, q, t);
+            if (d2 < best) {
+                best = d2;
+                bestT = t;
+            }
+        }
+        gPrev = g;
+    }
+
+    *outDist2 = best;
+    return bestT;
+}
+
+static CurveHit makeHit(const BSplineCurve* curve, int segment, double t, double dist2) {
+    CurveHit hit;
+    hit.segment = segment;
+    hit.t = (float)t;
+    hit.point = polyPosition(&curve->segments[segment - 1], t);
+    hit.distance = sqrt(dist2);
+    return hit;
+}
+
+// ============================================================================
+// BUILD
+// ============================================================================
+
+static double boxDistanceSquared(const AABB* box, Vec3 q) {
+    double dx = (q.x < box->min.x) ? box->min.x - q.x : (q.x > box->max.x ? q.x - box->max.x : 0.0);
+    double dy = (q.y < box->min.y) ? box->min.y - q.y : (q.y > box->max.y ? q.y - box->max.y : 0.0);
+    double dz = (q.z < box->min.z) ? box->min.z - q.z : (q.z > box->max.z ? q.z - box->max.z : 0.0);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+static double centroidOnAxis(const AABB* box, int axis) {
+    if (axis == 0) return box->min.x + box->max.x;
+    if (axis == 1) return box->min.y + box->max.y;
+    return box->min.z + box->max.z;
+}
+
+/**
+ * Partially sort order[lo, hi) so order[mid] has the median centroid (quickselect)
+ */
+static void selectMedian(int* order, const AABB* boxes, int axis, int lo, int hi, int mid) {
+    while (hi - lo > 1) {
+        double pivot = centroidOnAxis(&boxes[order[(lo + hi) / 2] - 1], axis);
+        int i = lo, j = hi - 1;
+        while (i <= j) {
+            while (centroidOnAxis(&boxes[order[i] - 1], axis) < pivot) i++;
+            while (centroidOnAxis(&boxes[order[j] - 1], axis) > pivot) j--;
+            if (i <= j) {
+                int tmp = order[i];
+                order[i] = order[j];
+                order[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (mid <= j) {
+            hi = j + 1;
+        } else if (mid >= i) {
+            lo = i;
+        } else {
+            return;
+        }
+    }
+}
+
+static int buildNode(SegmentBVH* bvh, const AABB* boxes, int first, int count, int parent) {
+    int index = bvh->numNodes++;
+    BVHNode* node = &bvh->nodes[index];
+    node->parent = parent;
+
+    AABB box = boxes[bvh->segmentOrder[first] - 1];
+    AABB centers = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+    for (int i = first; i < first + count; i++) {
+        const AABB* b = &boxes[bvh->segmentOrder[i] - 1];
+        Vec3 c = {centroidOnAxis(b, 0), centroidOnAxis(b, 1), centroidOnAxis(b, 2)};
+        AABB point = {c, c};
+        box = bspline_mergeBounds(box, *b);
+        centers = (i == first) ? point : bspline_mergeBounds(centers, point);
+    }
+    node->box = box;
+
+    if (count <= BVH_LEAF_SEGMENTS) {
+        node->first = first;
+        node->count = count;
+        node->left = node->right = -1;
+        for (int i = first; i < first + count; i++) {
+            bvh->segmentLeaf[bvh->segmentOrder[i] - 1] = index;
+        }
+        return index;
+    }
+
+    double ex = centers.max.x - centers.min.x;
+    double ey = centers.max.y - centers.min.y;
+    double ez = centers.max.z - centers.min.z;
+    int axis = (ex >= ey && ex >= ez) ? 0 : (ey >= ez ? 1 : 2);
+
+    int half = count / 2;
+    selectMedian(bvh->segmentOrder, boxes, axis, first, first + count, first + half);
+
+    node->first = 0;
+    node->count = 0;
+    int left = buildNode(bvh, boxes, first, half, index);
+    int right = buildNode(bvh, boxes, first + half, count - half, index);
+
+    // bvh->nodes is preallocated, so node pointers stay valid
+    bvh->nodes[index].left = left;
+    bvh->nodes[index].right = right;
+    return index;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+SegmentBVH* bspline_buildBVH(const Vec3* controlPoints, int numControlPoints, const BSplineCurve* curve) {
+    int numSegments = bspline_getNumSegments(numControlPoints);
+    if (!controlPoints || !curve || numSegments <= 0 || curve->numSegments != numSegments) {
+        fprintf(stderr, "Error: Invalid curve for BVH\n");
+        return NULL;
+    }
+
+    SegmentBVH* bvh = (SegmentBVH*)calloc(1, sizeof(SegmentBVH));
+    AABB* boxes = (AABB*)malloc(numSegments * sizeof(AABB));
+    if (bvh) {
+        bvh->nodes = (BVHNode*)malloc((2 * numSegments - 1) * sizeof(BVHNode));
+        bvh->segmentOrder = (int*)malloc(numSegments * sizeof(int));
+        bvh->segmentLeaf = (int*)malloc(numSegments * sizeof(int));
+    }
+    if (!bvh || !boxes || !bvh->nodes || !bvh->segmentOrder || !bvh->segmentLeaf) {
+        fprintf(stderr, "Error: Failed to allocate BVH\n");
+        free(boxes);
+        bspline_freeBVH(bvh);
+        return NULL;
+    }
+
+    bvh->curve = curve;
+    bvh->numSegments = numSegments;
+    bspline_computeSegmentBounds(controlPoints, numControlPoints, boxes);
+    for (int i = 0; i < numSegments; i++) {
+        bvh->segmentOrder[i] = i + 1;
+    }
+
+    buildNode(bvh, boxes, 0, numSegments, -1);
+
+    free(boxes);
+    return bvh;
+}
+
+void bspline_freeBVH(SegmentBVH* bvh) {
+    if (bvh) {
+        if (bvh->nodes) free(bvh->nodes);
+        if (bvh->segmentOrder) free(bvh->segmentOrder);
+        if (bvh->segmentLeaf) free(bvh->segmentLeaf);
+        free(bvh);
+    }
+}
+
+static void refitNode(SegmentBVH* bvh, BVHNode* node, const Vec3* controlPoints) {
+    if (node->count > 0) {
+        node->box = bspline_segmentBounds(controlPoints, bvh->segmentOrder[node->first]);
+        for (int k = 1; k < node->count; k++) {
+            AABB b = bspline_segmentBounds(controlPoints, bvh->segmentOrder[node->first + k]);
+            node->box = bspline_mergeBounds(node->box, b);
+        }
+    } else {
+        node->box = bspline_mergeBounds(bvh->nodes[node->left].box, bvh->nodes[node->right].box);
+    }
+}
+
+void bspline_refitBVH(SegmentBVH* bvh, const Vec3* controlPoints) {
+    if (!bvh || !controlPoints) return;
+
+    // Children always follow their parent, so a reverse sweep is bottom-up
+    for (int i = bvh->numNodes - 1; i >= 0; i--) {
+        refitNode(bvh, &bvh->nodes[i], controlPoints);
+    }
+}
+
+void bspline_refitBVHSegments(SegmentBVH* bvh, const Vec3* controlPoints, int firstSegment, int lastSegment) {
+    if (!bvh || !controlPoints) return;
+    if (firstSegment < 1) firstSegment = 1;
+    if (lastSegment > bvh->numSegments) lastSegment = bvh->numSegments;
+
+    int previousLeaf = -1;
+    for (int seg = firstSegment; seg <= lastSegment; seg++) {
+        int leaf = bvh->segmentLeaf[seg - 1];
+        if (leaf == previousLeaf) continue;  // Neighbouring segments often share a leaf
+        previousLeaf = leaf;
+
+        // Paths of nearby leaves overlap near the root; k log n stays small
+        for (int i = leaf; i >= 0; i = bvh->nodes[i].parent) {
+            refitNode(bvh, &bvh->nodes[i], controlPoints);
+        }
+    }
+}
+
+CurveHit bspline_closestPointOnSegment(const BSplineCurve* curve, int segment, Vec3 query) {
+    double dist2;
+    double t = solveSegment(&curve->segments[segment - 1], query, &dist2);
+    return makeHit(curve, segment, t, dist2);
+}
+
+/**
+ * Nearest-point traversal; best / bestT / bestSegment carry an initial candidate
+ */
+static void nearestSearch(const SegmentBVH* bvh, Vec3 q, double* best, double* bestT, int* bestSegment) {
+    int stack[BVH_STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const BVHNode* node = &bvh->nodes[stack[--top]];
+        if (boxDistanceSquared(&node->box, q) >= *best) continue;
+
+        if (node->count > 0) {
+            for (int k = 0; k < node->count; k++) {
+                int seg = bvh->segmentOrder[node->first + k];
+                if (seg == *bestSegment) continue;  // Already solved as the initial candidate
+                double d2;
+                double t = solveSegment(&bvh->curve->segments[seg - 1], q, &d2);
+                if (d2 < *best) {
+                    *best = d2;
+                    *bestT = t;
+                    *bestSegment = seg;
+                }
+            }
+            continue;
+        }
+
+        // Push the farther child first so the nearer one is visited next
+        double dl = boxDistanceSquared(&bvh->nodes[node->left].box, q);
+        double dr = boxDistanceSquared(&bvh->nodes[node->right].box, q);
+        if (top + 2 > BVH_STACK_SIZE) continue;  // Unreachable for median-split trees
+        if (dl < dr) {
+            stack[top++] = node->right;
+            stack[top++] = node->left;
+        } else {
+            stack[top++] = node->left;
+            stack[top++] = node->right;
+        }
+    }
+}
+
+int bspline_closestPoint(const SegmentBVH* bvh, Vec3 query, CurveHit* outHit) {
+    if (!bvh || bvh->numNodes == 0 || !outHit) return 0;
+
+    double best = INFINITY;
+    double bestT = 0.0;
+    int bestSegment = 0;
+    nearestSearch(bvh, query, &best, &bestT, &bestSegment);
+
+    *outHit = makeHit(bvh->curve, bestSegment, bestT, best);
+    return 1;
+}
+
+int bspline_queryRadius(const SegmentBVH* bvh, Vec3 query, double radius,
+                        CurveHit* outHits, int maxHits) {
+    if (!bvh || bvh->numNodes == 0 || !outHits || maxHits <= 0) return 0;
+
+    double r2 = radius * radius;
+    int numHits = 0;
+    int stack[BVH_STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0 && numHits < maxHits) {
+        const BVHNode* node = &bvh->nodes[stack[--top]];
+        if (boxDistanceSquared(&node->box, query) > r2) continue;
+
+        if (node->count > 0) {
+            for (int k = 0; k < node->count && numHits < maxHits; k++) {
+                int seg = bvh->segmentOrder[node->first + k];
+                double d2;
+                double t = solveSegment(&bvh->curve->segments[seg - 1], query, &d2);
+                if (d2 <= r2) {
+                    outHits[numHits++] = makeHit(bvh->curve, seg, t, d2);
+                }
+            }
+        } else if (top + 2 <= BVH_STACK_SIZE) {
+            stack[top++] = node->right;
+            stack[top++] = node->left;
+        }
+    }
+
+    return numHits;
+}
+
+void bspline_closestPointBatch(const SegmentBVH* bvh, const Vec3* queries, int count, CurveHit* outHits) {
+    if (!bvh || bvh->numNodes == 0 || !queries || !outHits) return;
+
+    int previous = 0;
+    for (int i = 0; i < count; i++) {
+        double best = INFINITY;
+        double bestT = 0.0;
+        int bestSegment = 0;
+
+        // Warm start: the previous answer usually bounds this one tightly
+        if (previous > 0) {
+            bestT = solveSegment(&bvh->curve->segments[previous - 1], queries[i], &best);
+            bestSegment = previous;
+        }
+        nearestSearch(bvh, queries[i], &best, &bestT, &bestSegment);
+
+        outHits[i] = makeHit(bvh->curve, bestSegment, bestT, best);
+        previous = bestSegment;
+    }
+}
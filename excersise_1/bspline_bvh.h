@@ -0,0 +1,139 @@
+#ifndef BSPLINE_BVH_H
+#define BSPLINE_BVH_H
+
+#include "bspline_curve.h"
+#include "bspline_bounds.h"
+
+// ============================================================================
+// CLOSEST-POINT QUERIES (SEGMENT BVH)
+// Bounding-volume hierarchy over the control-hull boxes of all segments.
+// A box is a conservative bound of its segment, so whole subtrees farther
+// away than the best hit so far are skipped; surviving segments are solved
+// exactly with safeguarded Newton iteration on d/dt |p(t) - q|^2 = 0.
+// ============================================================================
+
+/**
+ * BVH node (leaf if count > 0)
+ */
+typedef struct {
+    AABB box;    // Bounds of everything below this node
+    int left;    // Child node indices (internal nodes only)
+    int right;
+    int parent;  // Parent node index (-1 for the root)
+    int first;   // First entry in segmentOrder (leaves only)
+    int count;   // Number of segments in leaf (0 for internal nodes)
+} BVHNode;
+
+/**
+ * Segment hierarchy of one compiled curve
+ */
+typedef struct {
+    const BSplineCurve* curve;  // Curve the hierarchy was built for (not owned)
+    BVHNode* nodes;             // nodes[0] is the root; children follow their parent
+    int numNodes;
+    int* segmentOrder;          // Segment indices (1 to n-3) grouped by leaf
+    int* segmentLeaf;           // Leaf node holding each segment (index 0 = segment 1)
+    int numSegments;
+} SegmentBVH;
+
+/**
+ * Result of a closest-point query
+ */
+typedef struct {
+    int segment;      // Segment index (1 to n-3)
+    float t;          // Parameter in [0, 1]
+    Vec3 point;       // Position on the curve
+    double distance;  // Distance from the query point
+} CurveHit;
+
+/**
+ * Build hierarchy (median split along the longest axis)
+ *
+ * @param controlPoints Control points the curve was compiled from
+ * @param numControlPoints Number of control points (at least 4)
+ * @param curve Compiled curve (must outlive the hierarchy)
+ * @return Newly allocated BVH (free with bspline_freeBVH), or NULL on error
+ */
+SegmentBVH* bspline_buildBVH(const Vec3* controlPoints, int numControlPoints, const BSplineCurve* curve);
+
+/**
+ * Free hierarchy
+ *
+ * @param bvh Hierarchy to free (NULL is allowed)
+ */
+void bspline_freeBVH(SegmentBVH* bvh);
+
+/**
+ * Recompute all boxes after control points moved (topology is kept)
+ *
+ * Cheaper than a rebuild; query cost degrades only if points move far.
+ *
+ * @param bvh Hierarchy
+ * @param controlPoints Updated control points (same count as at build time)
+ */
+void bspline_refitBVH(SegmentBVH* bvh, const Vec3* controlPoints);
+
+/**
+ * Recompute boxes after some segments changed
+ *
+ * Only the leaves holding firstSegment .. lastSegment and their paths to
+ * the root are updated, O(k log n) for k segments. Moving one control point
+ * changes at most four segments (see bspline_affectedSegments).
+ *
+ * @param bvh Hierarchy
+ * @param controlPoints Updated control points (same count as at build time)
+ * @param firstSegment First changed segment (1 to n-3)
+ * @param lastSegment Last changed segment (1 to n-3)
+ */
+void bspline_refitBVHSegments(SegmentBVH* bvh, const Vec3* controlPoints, int firstSegment, int lastSegment);
+
+/**
+ * Closest point on one segment
+ *
+ * @param curve Compiled curve
+ * @param segment Segment index (1 to n-3)
+ * @param query Query point
+ * @return Closest point on that segment
+ */
+CurveHit bspline_closestPointOnSegment(const BSplineCurve* curve, int segment, Vec3 query);
+
+/**
+ * Closest point on the whole curve
+ *
+ * @param bvh Hierarchy
+ * @param query Query point
+ * @param outHit Output closest point
+ * @return 1 on success, 0 if the hierarchy is empty
+ */
+int bspline_closestPoint(const SegmentBVH* bvh, Vec3 query, CurveHit* outHit);
+
+/**
+ * Segments passing within a radius of a point
+ *
+ * Reports the closest point of every segment whose distance is <= radius.
+ *
+ * @param bvh Hierarchy
+ * @param query Query point
+ * @param radius Search radius
+ * @param outHits Output array
+ * @param maxHits Capacity of outHits
+ * @return Number of hits written (at most maxHits)
+ */
+int bspline_queryRadius(const SegmentBVH* bvh, Vec3 query, double radius,
+                        CurveHit* outHits, int maxHits);
+
+/**
+ * Closest points for many query points
+ *
+ * Each query starts from the previous query's segment as its first
+ * candidate, so spatially coherent batches (e.g. the pixels around a mouse
+ * click) prune most of the tree immediately.
+ *
+ * @param bvh Hierarchy
+ * @param queries Query points
+ * @param count Number of queries
+ * @param outHits Output array with count entries
+ */
+void bspline_closestPointBatch(const SegmentBVH* bvh, const Vec3* queries, int count, CurveHit* outHits);
+
+#endif // BSPLINE_BVH_H
@@ -0,0 +1,163 @@
+#include "bspline_curve.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// ============================================================================
+// COMPILATION
+// ============================================================================
+
+/**
+ * Rows of (1/6) * B_{i,3} applied to R_i = [r_{i-1}, r_i, r_{i+1}, r_{i+2}]:
+ *   a = (-r0 + 3r1 - 3r2 + r3) / 6
+ *   b = ( 3r0 - 6r1 + 3r2)     / 6
+ *   c = (-3r0       + 3r2)     / 6
+ *   d = (  r0 + 4r1 +  r2)     / 6
+ */
+void bspline_segmentPowerForm(const Vec3 r[4], Vec3 out[4]) {
+    out[0] = (Vec3){
+        (-r[0].x + 3.0 * r[1].x - 3.0 * r[2].x + r[3].x) / 6.0,
+        (-r[0].y + 3.0 * r[1].y - 3.0 * r[2].y + r[3].y) / 6.0,
+        (-r[0].z + 3.0 * r[1].z - 3.0 * r[2].z + r[3].z) / 6.0
+    };
+    out[1] = (Vec3){
+        (r[0].x - 2.0 * r[1].x + r[2].x) / 2.0,
+        (r[0].y - 2.0 * r[1].y + r[2].y) / 2.0,
+        (r[0].z - 2.0 * r[1].z + r[2].z) / 2.0
+    };
+    out[2] = (Vec3){
+        (r[2].x - r[0].x) / 2.0,
+        (r[2].y - r[0].y) / 2.0,
+        (r[2].z - r[0].z) / 2.0
+    };
+    out[3] = (Vec3){
+        (r[0].x + 4.0 * r[1].x + r[2].x) / 6.0,
+        (r[0].y + 4.0 * r[1].y + r[2].y) / 6.0,
+        (r[0].z + 4.0 * r[1].z + r[2].z) / 6.0
+    };
+}
+
+void bspline_compileSegment(BSplineCurve* curve, const Vec3* controlPoints, int segment) {
+    if (!curve || !controlPoints || segment < 1 || segment > curve->numSegments) return;
+
+    BSplineSegmentPoly* poly = &curve->segments[segment - 1];
+    bspline_segmentPowerForm(controlPoints + (segment - 1), poly->pos);
+    Vec3 a = poly->pos[0];
+    Vec3 b = poly->pos[1];
+    Vec3 c = poly->pos[2];
+
+    // First derivative: 3a t^2 + 2b t + c
+    poly->d1[0] = (Vec3){3.0 * a.x, 3.0 * a.y, 3.0 * a.z};
+    poly->d1[1] = (Vec3){2.0 * b.x, 2.0 * b.y, 2.0 * b.z};
+    poly->d1[2] = c;
+
+    // Second derivative: 6a t + 2b
+    poly->d2[0] = (Vec3){6.0 * a.x, 6.0 * a.y, 6.0 * a.z};
+    poly->d2[1] = (Vec3){2.0 * b.x, 2.0 * b.y, 2.0 * b.z};
+}
+
+BSplineCurve* bspline_compileCurve(const Vec3* controlPoints, int numControlPoints) {
+    int numSegments = bspline_getNumSegments(numControlPoints);
+    if (!controlPoints || numSegments <= 0) {
+        fprintf(stderr, "Error: Need at least 4 control points to compile curve\n");
+        return NULL;
+    }
+
+    BSplineCurve* curve = (BSplineCurve*)malloc(sizeof(BSplineCurve));
+    if (!curve) return NULL;
+
+    curve->segments = (BSplineSegmentPoly*)malloc(numSegments * sizeof(BSplineSegmentPoly));
+    if (!curve->segments) {
+        free(curve);
+        return NULL;
+    }
+    curve->numSegments = numSegments;
+
+    for (int seg = 1; seg <= numSegments; seg++) {
+        bspline_compileSegment(curve, controlPoints, seg);
+    }
+
+    return curve;
+}
+
+void bspline_freeCurve(BSplineCurve* curve) {
+    if (curve) {
+        if (curve->segments) free(curve->segments);
+        free(curve);
+    }
+}
+
+// ============================================================================
+// EVALUATION (HORNER)
+// ============================================================================
+
+Vec3 bspline_curvePosition(const BSplineCurve* curve, int segment, float t) {
+    const Vec3* k = curve->segments[segment - 1].pos;
+    double s = t;
+    return (Vec3){
+        ((k[0].x * s + k[1].x) * s + k[2].x) * s + k[3].x,
+        ((k[0].y * s + k[1].y) * s + k[2].y) * s + k[3].y,
+        ((k[0].z * s + k[1].z) * s + k[2].z) * s + k[3].z
+    };
+}
+
+Vec3 bspline_curveTangent(const BSplineCurve* curve, int segment, float t) {
+    const Vec3* k = curve->segments[segment - 1].d1;
+    double s = t;
+    return (Vec3){
+        (k[0].x * s + k[1].x) * s + k[2].x,
+        (k[0].y * s + k[1].y) * s + k[2].y,
+        (k[0].z * s + k[1].z) * s + k[2].z
+    };
+}
+
+Vec3 bspline_curveSecondDerivative(const BSplineCurve* curve, int segment, float t) {
+    const Vec3* k = curve->segments[segment - 1].d2;
+    double s = t;
+    return (Vec3){
+        k[0].x * s + k[1].x,
+        k[0].y * s + k[1].y,
+        k[0].z * s + k[1].z
+    };
+}
+
+double bspline_curveCurvature(const BSplineCurve* curve, int segment, float t) {
+    Vec3 d1 = bspline_curveTangent(curve, segment, t);
+    Vec3 d2 = bspline_curveSecondDerivative(curve, segment, t);
+
+    double speed = bspline_length(d1);
+    if (speed < 1e-9) return 0.0;
+
+    return bspline_length(bspline_cross(d1, d2)) / (speed * speed * speed);
+}
+
+CurveJet bspline_curveJet(const BSplineCurve* curve, int segment, float t, FrenetFrame* outFrame) {
+    const BSplineSegmentPoly* poly = &curve->segments[segment - 1];
+    const Vec3* k = poly->pos;
+    const Vec3* d1 = poly->d1;
+    const Vec3* d2 = poly->d2;
+    double s = t;
+
+    CurveJet jet;
+    jet.position = (Vec3){
+        ((k[0].x * s + k[1].x) * s + k[2].x) * s + k[3].x,
+        ((k[0].y * s + k[1].y) * s + k[2].y) * s + k[3].y,
+        ((k[0].z * s + k[1].z) * s + k[2].z) * s + k[3].z
+    };
+    jet.tangent = (Vec3){
+        (d1[0].x * s + d1[1].x) * s + d1[2].x,
+        (d1[0].y * s + d1[1].y) * s + d1[2].y,
+        (d1[0].z * s + d1[1].z) * s + d1[2].z
+    };
+    jet.secondDerivative = (Vec3){
+        d2[0].x * s + d2[1].x,
+        d2[0].y * s + d2[1].y,
+        d2[0].z * s + d2[1].z
+    };
+
+    if (outFrame) {
+        *outFrame = bspline_frenetFromDerivatives(jet.tangent, jet.secondDerivative);
+    }
+
+    return jet;
+}
@@ -0,0 +1,121 @@
+#ifndef BSPLINE_CURVE_H
+#define BSPLINE_CURVE_H
+
+#include "bspline.h"
+
+// ============================================================================
+// COMPILED B-SPLINE CURVE (POWER FORM)
+// For a fixed control polygon every segment of equation 1.2 is a cubic
+//   p_i(t) = a t^3 + b t^2 + c t + d
+// Coefficients are computed once; queries use Horner's rule.
+// ============================================================================
+
+/**
+ * Power-form coefficients of one segment and of its derivatives
+ */
+typedef struct {
+    Vec3 pos[4];  // p(t)   = pos[0] t^3 + pos[1] t^2 + pos[2] t + pos[3]
+    Vec3 d1[3];   // p'(t)  = d1[0] t^2 + d1[1] t + d1[2]   (3a, 2b, c)
+    Vec3 d2[2];   // p''(t) = d2[0] t + d2[1]               (6a, 2b)
+} BSplineSegmentPoly;
+
+/**
+ * Compiled curve: one polynomial per segment
+ *
+ * segments[0] holds segment 1, so segment indexing matches bspline.h (1 to n-3).
+ */
+typedef struct {
+    BSplineSegmentPoly* segments;  // numSegments entries
+    int numSegments;               // n - 3
+} BSplineCurve;
+
+/**
+ * Convert one segment to power form p(t) = a t^3 + b t^2 + c t + d
+ *
+ * Shared by every evaluator that works on the power form (compiled curves,
+ * batch kernels, bulk baking, curve storage).
+ *
+ * @param r Control points r_{i-1}, r_i, r_{i+1}, r_{i+2} of the segment
+ * @param out Output coefficients {a, b, c, d}
+ */
+void bspline_segmentPowerForm(const Vec3 r[4], Vec3 out[4]);
+
+/**
+ * Compile control points into per-segment polynomial coefficients
+ *
+ * @param controlPoints Array of control points
+ * @param numControlPoints Number of control points (at least 4)
+ * @return Newly allocated curve (free with bspline_freeCurve), or NULL on error
+ */
+BSplineCurve* bspline_compileCurve(const Vec3* controlPoints, int numControlPoints);
+
+/**
+ * Free compiled curve
+ *
+ * @param curve Curve to free (NULL is allowed)
+ */
+void bspline_freeCurve(BSplineCurve* curve);
+
+/**
+ * Recompute coefficients of one segment after its control points changed
+ *
+ * @param curve Compiled curve
+ * @param controlPoints Array of control points the curve was compiled from
+ * @param segment Segment index (1 to n-3)
+ */
+void bspline_compileSegment(BSplineCurve* curve, const Vec3* controlPoints, int segment);
+
+/**
+ * Evaluate position (equation 1.2) on compiled curve
+ *
+ * @param curve Compiled curve
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1]
+ * @return Position vector on the curve
+ */
+Vec3 bspline_curvePosition(const BSplineCurve* curve, int segment, float t);
+
+/**
+ * Evaluate tangent (equation 1.3) on compiled curve
+ *
+ * @param curve Compiled curve
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1]
+ * @return Tangent vector (unnormalized)
+ */
+Vec3 bspline_curveTangent(const BSplineCurve* curve, int segment, float t);
+
+/**
+ * Evaluate second derivative on compiled curve
+ *
+ * @param curve Compiled curve
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1]
+ * @return Second derivative vector
+ */
+Vec3 bspline_curveSecondDerivative(const BSplineCurve* curve, int segment, float t);
+
+/**
+ * Curvature kappa = |p' x p''| / |p'|^3
+ *
+ * @param curve Compiled curve
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1]
+ * @return Curvature (0 for straight or degenerate points)
+ */
+double bspline_curveCurvature(const BSplineCurve* curve, int segment, float t);
+
+/**
+ * Evaluate position, tangent and second derivative in one pass
+ *
+ * Compiled-curve counterpart of bspline_evaluateJet.
+ *
+ * @param curve Compiled curve
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1]
+ * @param outFrame Optional output Frenet-Serret frame (NULL to skip)
+ * @return p, p' and p'' at t
+ */
+CurveJet bspline_curveJet(const BSplineCurve* curve, int segment, float t, FrenetFrame* outFrame);
+
+#endif // BSPLINE_CURVE_H
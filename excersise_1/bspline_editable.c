@@ -0,0 +1,154 @@
+#include "bspline_editable.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// ============================================================================
+// CREATION AND DESTRUCTION
+// ============================================================================
+
+EditableCurve* bspline_createEditable(Vec3* controlPoints, int numControlPoints) {
+    if (!controlPoints || numControlPoints < 4) {
+        fprintf(stderr, "Error: Editable curve needs at least 4 control points\n");
+        return NULL;
+    }
+
+    EditableCurve* editable = (EditableCurve*)calloc(1, sizeof(EditableCurve));
+    if (!editable) return NULL;
+
+    editable->numControlPoints = numControlPoints;
+    editable->numSegments = bspline_getNumSegments(numControlPoints);
+    editable->curve = bspline_compileCurve(controlPoints, numControlPoints);
+    editable->bounds = (AABB*)malloc(editable->numSegments * sizeof(AABB));
+    editable->dirty = (unsigned char*)calloc(editable->numSegments, 1);
+    editable->dirtySegments = (int*)malloc(editable->numSegments * sizeof(int));
+
+    if (!editable->curve || !editable->bounds || !editable->dirty || !editable->dirtySegments) {
+        fprintf(stderr, "Error: Failed to allocate editable curve\n");
+        bspline_freeEditable(editable);  // Does not own controlPoints yet
+        return NULL;
+    }
+
+    editable->controlPoints = controlPoints;
+    bspline_computeSegmentBounds(controlPoints, numControlPoints, editable->bounds);
+
+    return editable;
+}
+
+void bspline_freeEditable(EditableCurve* editable) {
+    if (!editable) return;
+
+    if (editable->controlPoints) free(editable->controlPoints);
+    if (editable->curve) bspline_freeCurve(editable->curve);
+    if (editable->bounds) free(editable->bounds);
+    if (editable->dirty) free(editable->dirty);
+    if (editable->dirtySegments) free(editable->dirtySegments);
+    free(editable);
+}
+
+void bspline_attachCaches(EditableCurve* editable, BSplineTessellation* tessellation,
+                          ArcLengthTable* arcTable, AdaptiveTessellation* adaptive, RMFTable* rmfTable) {
+    if (!editable) return;
+
+    if (arcTable && arcTable->curve != editable->curve) {
+        fprintf(stderr, "Error: Arc-length table was built for a different curve\n");
+        arcTable = NULL;
+    }
+    if (rmfTable && rmfTable->numSegments != editable->numSegments) {
+        fprintf(stderr, "Error: Rotation-minimizing frames were built for a different curve\n");
+        rmfTable = NULL;
+    }
+    editable->tessellation = tessellation;
+    editable->arcTable = arcTable;
+    editable->adaptive = adaptive;
+    editable->rmfTable = rmfTable;
+}
+
+// ============================================================================
+// EDITING
+// ============================================================================
+
+int bspline_affectedSegments(int pointIndex, int numSegments, int* outFirst, int* outLast) {
+    if (pointIndex < 0 || pointIndex >= numSegments + 3) return 0;
+
+    // Segment i uses points i-1 .. i+2 (0-based), so point j feeds i = j-2 .. j+1
+    int first = pointIndex - 2;
+    int last = pointIndex + 1;
+    if (first < 1) first = 1;
+    if (last > numSegments) last = numSegments;
+
+    *outFirst = first;
+    *outLast = last;
+    return last - first + 1;
+}
+
+int bspline_moveControlPoint(EditableCurve* editable, int pointIndex, Vec3 position) {
+    int first, last;
+    if (!editable || !bspline_affectedSegments(pointIndex, editable->numSegments, &first, &last)) {
+        return 0;
+    }
+
+    editable->controlPoints[pointIndex] = position;
+    editable->revision++;
+
+    for (int seg = first; seg <= last; seg++) {
+        bspline_compileSegment(editable->curve, editable->controlPoints, seg);
+        editable->bounds[seg - 1] = bspline_segmentBounds(editable->controlPoints, seg);
+
+        if (!editable->dirty[seg - 1]) {
+            editable->dirty[seg - 1] = 1;
+            editable->dirtySegments[editable->numDirty++] = seg;
+        }
+    }
+
+    return last - first + 1;
+}
+
+// ============================================================================
+// CACHE REFRESH
+// ============================================================================
+
+int bspline_updateEditable(EditableCurve* editable) {
+    if (!editable || editable->numDirty == 0) return 0;
+
+    int* list = editable->dirtySegments;
+    int count = editable->numDirty;
+
+    // Insertion sort - a handful of entries per frame, nearly sorted already
+    for (int i = 1; i < count; i++) {
+        int seg = list[i];
+        int j = i - 1;
+        while (j >= 0 && list[j] > seg) {
+            list[j + 1] = list[j];
+            j--;
+        }
+        list[j + 1] = seg;
+    }
+
+    BSplineTessellation* tess = editable->tessellation;
+    if (tess && tess->vertices && tess->numVertices > 0) {
+        int stride = tess->samplesPerSegment - 1;  // Joint vertex is shared
+        for (int i = 0; i < count; i++) {
+            float* slice = tess->vertices + (size_t)(list[i] - 1) * stride * 3;
+            bspline_tessellateSegment(editable->curve, list[i], tess->samplesPerSegment, slice);
+        }
+    }
+
+    if (editable->arcTable) {
+        bspline_updateArcLengthSegments(editable->arcTable, list, count);
+    }
+
+    if (editable->adaptive) {
+        bspline_markAdaptiveSegments(editable->adaptive, list, count);
+    }
+
+    if (editable->rmfTable) {
+        bspline_updateRMFTable(editable->rmfTable, editable->curve, list[0]);  // Sorted: first dirty
+    }
+
+    for (int i = 0; i < count; i++) {
+        editable->dirty[list[i] - 1] = 0;
+    }
+    editable->numDirty = 0;
+
+    return count;
+}
@@ -0,0 +1,115 @@
+#ifndef BSPLINE_EDITABLE_H
+#define BSPLINE_EDITABLE_H
+
+#include "bspline_curve.h"
+#include "bspline_bounds.h"
+#include "bspline_tessellate.h"
+#include "bspline_arclength.h"
+#include "bspline_adaptive.h"
+#include "bspline_rmf.h"
+
+// ============================================================================
+// EDITABLE CURVE WITH DIRTY-SEGMENT TRACKING
+// Control point r_j only appears in segments j-1 .. j+2 (equation 1.2 uses
+// r_{i-1} .. r_{i+2} for segment i), so moving one point invalidates at
+// most four segments. Only those are recomputed in the derived caches.
+// ============================================================================
+
+/**
+ * Control polygon together with the data derived from it
+ *
+ * Coefficients and bounds are refreshed immediately on every edit (O(1)).
+ * Attached caches are refreshed for dirty segments only, when
+ * bspline_updateEditable is called (typically once per frame).
+ */
+typedef struct {
+    Vec3* controlPoints;               // Owned control polygon
+    int numControlPoints;
+    int numSegments;                   // numControlPoints - 3
+    BSplineCurve* curve;               // Owned, always up to date
+    AABB* bounds;                      // Owned, per segment (index 0 = segment 1), always up to date
+
+    BSplineTessellation* tessellation; // Attached cache (not owned), or NULL
+    ArcLengthTable* arcTable;          // Attached cache (not owned), or NULL
+    AdaptiveTessellation* adaptive;    // Attached cache (not owned), or NULL
+    RMFTable* rmfTable;                // Attached cache (not owned), or NULL
+
+    unsigned char* dirty;              // Per segment: attached caches are stale
+    int* dirtySegments;                // Stale segment indices, numDirty entries
+    int numDirty;
+    unsigned long revision;            // Incremented by every edit
+} EditableCurve;
+
+/**
+ * Wrap a control polygon for editing
+ *
+ * Takes ownership of controlPoints (it is freed by bspline_freeEditable).
+ *
+ * @param controlPoints malloc'ed array of control points
+ * @param numControlPoints Number of control points (at least 4)
+ * @return Newly allocated editable curve, or NULL on error
+ */
+EditableCurve* bspline_createEditable(Vec3* controlPoints, int numControlPoints);
+
+/**
+ * Free editable curve, its control points, coefficients and bounds
+ *
+ * Attached caches are left to their owner.
+ *
+ * @param editable Curve to free (NULL is allowed)
+ */
+void bspline_freeEditable(EditableCurve* editable);
+
+/**
+ * Attach caches that are kept in sync with edits
+ *
+ * All must have been built from editable->curve. Pass NULL to detach.
+ *
+ * @param editable Editable curve
+ * @param tessellation Tessellation of editable->curve, or NULL
+ * @param arcTable Arc-length table of editable->curve, or NULL
+ * @param adaptive Adaptive tessellation of editable->curve, or NULL
+ * @param rmfTable Rotation-minimizing frames of editable->curve, or NULL
+ */
+void bspline_attachCaches(EditableCurve* editable, BSplineTessellation* tessellation,
+                          ArcLengthTable* arcTable, AdaptiveTessellation* adaptive, RMFTable* rmfTable);
+
+/**
+ * Segments that use a control point
+ *
+ * @param pointIndex Control point index (0 to n-1)
+ * @param numSegments Number of segments
+ * @param outFirst Output first affected segment
+ * @param outLast Output last affected segment
+ * @return Number of affected segments (1 to 4, 0 if the index is invalid)
+ */
+int bspline_affectedSegments(int pointIndex, int numSegments, int* outFirst, int* outLast);
+
+/**
+ * Move one control point
+ *
+ * Recompiles coefficients and bounds of the affected segments and marks
+ * them dirty for the attached caches.
+ *
+ * @param editable Editable curve
+ * @param pointIndex Control point index (0 to n-1)
+ * @param position New position
+ * @return Number of segments invalidated (0 if the index is invalid)
+ */
+int bspline_moveControlPoint(EditableCurve* editable, int pointIndex, Vec3 position);
+
+/**
+ * Bring attached caches up to date
+ *
+ * Re-tessellates the dirty segments in place and re-integrates their
+ * arc-length entries, then clears the dirty set. The adaptive tessellation
+ * only has those segments marked stale; its next update rebuilds them.
+ * Rotation-minimizing frames chain along the curve, so they are
+ * re-propagated from the first dirty segment to the end.
+ *
+ * @param editable Editable curve
+ * @return Number of segments refreshed
+ */
+int bspline_updateEditable(EditableCurve* editable);
+
+#endif // BSPLINE_EDITABLE_H
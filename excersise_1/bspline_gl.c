@@ -0,0 +1,76 @@
+#include "bspline_gl.h"
+
+#ifdef __APPLE__
+    #include <GLUT/glut.h>
+#else
+    #include <GL/glut.h>
+#endif
+
+// ============================================================================
+// EULER ANGLES (Section 1.3)
+// ============================================================================
+
+/**
+ * Apply Euler angles orientation in OpenGL
+ * 
+ * Call this after glTranslatef to apply orientation.
+ * Order: Yaw → Pitch → Roll
+ * 
+ * @param angles Euler angles in degrees
+ */
+void bspline_applyOrientation(EulerAngles angles) {
+    // OpenGL rotations are applied in reverse order
+    // We want: Yaw → Pitch → Roll
+    // So we write: Roll → Pitch → Yaw
+    glRotatef(angles.roll, 1.0f, 0.0f, 0.0f);   // Roll around X
+    glRotatef(angles.pitch, 0.0f, 1.0f, 0.0f);  // Pitch around Y
+    glRotatef(angles.yaw, 0.0f, 0.0f, 1.0f);    // Yaw around Z
+}
+
+// ============================================================================
+// AXIS-ANGLE ROTATION (Section 1.4)
+// ============================================================================
+
+/**
+ * Apply axis-angle rotation in OpenGL
+ * 
+ * Convenience wrapper for glRotatef with AxisAngle structure.
+ * 
+ * @param aa Axis-angle rotation (angle in degrees, axis as normalized vector)
+ */
+void bspline_applyAxisAngle(AxisAngle aa) {
+    glRotatef(aa.angle, aa.axis.x, aa.axis.y, aa.axis.z);
+}
+
+// ============================================================================
+// DCM MATRIX ORIENTATION (Section 1.6 - Frenet-Serret Frame)
+// ============================================================================
+
+/**
+ * Apply Frenet-Serret frame orientation in OpenGL
+ * 
+ * This function applies the DCM matrix (equation 1.9) to orient the object
+ * along the curve using the tangent, normal, and binormal vectors.
+ * 
+ * The object's local X-axis will align with the tangent (forward),
+ * Y-axis with the normal (up), and Z-axis with the binormal (right).
+ * 
+ * Call this after glTranslatef to apply orientation.
+ * 
+ * @param frame Frenet-Serret frame
+ */
+void bspline_applyFrenetFrame(FrenetFrame frame) {
+    float matrix[16];
+    bspline_frenetToMatrix(frame, matrix, 1);  // Use inverse (transpose)
+    glMultMatrixf(matrix);
+}
+
+// ============================================================================
+// QUATERNION
+// ============================================================================
+
+void quat_applyRotation(Quat q) {
+    float matrix[16];
+    quat_toMatrix(q, matrix);
+    glMultMatrixf(matrix);
+}
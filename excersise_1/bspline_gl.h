@@ -0,0 +1,54 @@
+#ifndef BSPLINE_GL_H
+#define BSPLINE_GL_H
+
+#include "bspline.h"
+#include "quaternion.h"
+
+// ============================================================================
+// OPENGL ORIENTATION HELPERS
+// The only part of the curve math that talks to OpenGL. Kept out of the core
+// library (libbspline) so headless tools can link it without GL.
+// ============================================================================
+
+/**
+ * Apply Euler angles orientation in OpenGL
+ * 
+ * Call this after glTranslatef to apply orientation.
+ * Applies rotations in order: Roll → Pitch → Yaw
+ * 
+ * @param angles Euler angles in degrees
+ */
+void bspline_applyOrientation(EulerAngles angles);
+
+/**
+ * Apply axis-angle rotation in OpenGL
+ * 
+ * Convenience function for applying AxisAngle rotation.
+ * Equivalent to: glRotatef(aa.angle, aa.axis.x, aa.axis.y, aa.axis.z)
+ * 
+ * @param aa Axis-angle rotation
+ */
+void bspline_applyAxisAngle(AxisAngle aa);
+
+/**
+ * Apply Frenet-Serret frame orientation in OpenGL
+ * 
+ * Applies DCM matrix (equation 1.9) to orient object along curve
+ * using tangent, normal, and binormal vectors.
+ * 
+ * Call after glTranslatef to apply orientation.
+ * 
+ * @param frame Frenet-Serret frame
+ */
+void bspline_applyFrenetFrame(FrenetFrame frame);
+
+/**
+ * Apply quaternion rotation in OpenGL (glMultMatrixf)
+ *
+ * Call after glTranslatef, like bspline_applyAxisAngle.
+ *
+ * @param q Unit quaternion
+ */
+void quat_applyRotation(Quat q);
+
+#endif // BSPLINE_GL_H
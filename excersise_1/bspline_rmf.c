@@ -0,0 +1,232 @@
+#include "bspline_rmf.h"
+#include "vec3_batch.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static Vec3 vecSub(Vec3 a, Vec3 b) {
+    return (Vec3){a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+static Vec3 vecScaleSub(Vec3 a, double s, Vec3 b) {
+    return (Vec3){a.x - s * b.x, a.y - s * b.y, a.z - s * b.z};
+}
+
+/**
+ * Reflect v in the plane with normal n (n need not be unit length)
+ */
+static Vec3 reflect(Vec3 v, Vec3 n, double nn) {
+    return vecScaleSub(v, 2.0 * bspline_dot(n, v) / nn, n);
+}
+
+/**
+ * Make frame orthonormal, keeping tangent direction exact
+ */
+static FrenetFrame orthonormalize(Vec3 tangent, Vec3 normal) {
+    FrenetFrame frame;
+    frame.tangent = bspline_normalize(tangent);
+    frame.normal = bspline_normalize(
+        vecScaleSub(normal, bspline_dot(normal, frame.tangent), frame.tangent));
+    frame.binormal = bspline_cross(frame.tangent, frame.normal);
+    return frame;
+}
+
+// ============================================================================
+// TABLE CONSTRUCTION
+// ============================================================================
+
+/**
+ * Double reflection step from frame i (at x0) to the point x1 with tangent t1
+ *
+ *   v1 = x1 - x0               reflect r0, t0 in plane of v1  -> rL, tL
+ *   v2 = t1 - tL               reflect rL in plane of v2      -> r1
+ *
+ * Degenerate reflections (v1 or v2 ~ 0) are skipped - the frame is then
+ * already correct for that step.
+ */
+static FrenetFrame doubleReflection(FrenetFrame f0, Vec3 x0, Vec3 x1, Vec3 t1) {
+    Vec3 r = f0.normal;
+    Vec3 t = f0.tangent;
+
+    Vec3 v1 = vecSub(x1, x0);
+    double c1 = bspline_dot(v1, v1);
+    if (c1 > 1e-18) {
+        r = reflect(r, v1, c1);
+        t = reflect(t, v1, c1);
+    }
+
+    Vec3 v2 = vecSub(t1, t);
+    double c2 = bspline_dot(v2, v2);
+    if (c2 > 1e-18) {
+        r = reflect(r, v2, c2);
+    }
+
+    return orthonormalize(t1, r);
+}
+
+FrenetFrame bspline_startRMF(const BSplineCurve* curve) {
+    FrenetFrame frame;
+    bspline_curveJet(curve, 1, 0.0f, &frame);
+    return frame;
+}
+
+FrenetFrame bspline_stepRMF(FrenetFrame previous, Vec3 previousPosition, Vec3 position, Vec3 tangent) {
+    return doubleReflection(previous, previousPosition, position, bspline_normalize(tangent));
+}
+
+/**
+ * Rotation bspline_applyFrenetFrame applies for a frame
+ *
+ * q and -q are the same rotation; the result is flipped into the
+ * hemisphere of `previous` so neighbouring keys nlerp the short way.
+ */
+static Quat frameToKey(FrenetFrame frame, const Quat* previous) {
+    float matrix[16];
+    bspline_frenetToMatrix(frame, matrix, 1);
+    Quat q = quat_fromMatrix(matrix);
+    if (previous && previous->w * q.w + previous->x * q.x + previous->y * q.y + previous->z * q.z < 0.0f) {
+        q = (Quat){-q.w, -q.x, -q.y, -q.z};
+    }
+    return q;
+}
+
+/**
+ * Frame whose bspline_applyFrenetFrame rotation is q
+ *
+ * The rows of the rotation matrix are the tangent, normal and binormal.
+ */
+static FrenetFrame keyToFrame(Quat q) {
+    float m[16];
+    quat_toMatrix(q, m);
+    FrenetFrame frame;
+    frame.tangent = (Vec3){m[0], m[4], m[8]};
+    frame.normal = (Vec3){m[1], m[5], m[9]};
+    frame.binormal = (Vec3){m[2], m[6], m[10]};
+    return frame;
+}
+
+/**
+ * Propagate frames from the start of firstSegment to the curve end
+ *
+ * Key (firstSegment - 1) * steps is the starting frame: the Frenet frame
+ * at the curve start for segment 1, otherwise the key already stored.
+ *
+ * @return 1 on success, 0 if out of memory (table unchanged)
+ */
+static int propagate(RMFTable* table, const BSplineCurve* curve, int firstSegment) {
+    // Per-segment scratch: sample positions and tangents (normalized in bulk)
+    int perSegment = table->samplesPerSegment - 1;
+    Vec3* positions = (Vec3*)malloc(2 * (size_t)perSegment * sizeof(Vec3));
+    if (!positions) return 0;
+    Vec3* tangents = positions + perSegment;
+
+    // The chain is carried in double precision; only the stored keys are
+    // float quaternions
+    int k = (firstSegment - 1) * perSegment;
+    FrenetFrame frame;
+    if (firstSegment == 1) {
+        frame = bspline_startRMF(curve);
+        table->rotations[0] = frameToKey(frame, NULL);
+    } else {
+        frame = keyToFrame(table->rotations[k]);
+    }
+    Vec3 prevPos = bspline_curvePosition(curve, firstSegment, 0.0f);
+    k++;
+
+    for (int seg = firstSegment; seg <= curve->numSegments; seg++) {
+        for (int i = 0; i < perSegment; i++) {
+            float t = (float)(i + 1) / (float)perSegment;
+            CurveJet jet = bspline_curveJet(curve, seg, t, NULL);
+            positions[i] = jet.position;
+            tangents[i] = jet.tangent;
+        }
+        vec3_normalizeArray(tangents, tangents, perSegment);
+
+        // The reflections chain frame to frame, so this part stays sequential
+        for (int i = 0; i < perSegment; i++) {
+            frame = doubleReflection(frame, prevPos, positions[i], tangents[i]);
+            table->rotations[k] = frameToKey(frame, &table->rotations[k - 1]);
+            prevPos = positions[i];
+            k++;
+        }
+    }
+
+    free(positions);
+    return 1;
+}
+
+RMFTable* bspline_buildRMFTable(const BSplineCurve* curve, int samplesPerSegment) {
+    if (!curve || curve->numSegments <= 0 || samplesPerSegment < 2) {
+        fprintf(stderr, "Error: Invalid curve for rotation-minimizing frames\n");
+        return NULL;
+    }
+
+    RMFTable* table = (RMFTable*)calloc(1, sizeof(RMFTable));
+    if (!table) return NULL;
+
+    table->numSegments = curve->numSegments;
+    table->samplesPerSegment = samplesPerSegment;
+    table->numKeys = curve->numSegments * (samplesPerSegment - 1) + 1;
+    table->rotations = (Quat*)malloc(table->numKeys * sizeof(Quat));
+    if (!table->rotations || !propagate(table, curve, 1)) {
+        bspline_freeRMFTable(table);
+        return NULL;
+    }
+    return table;
+}
+
+int bspline_updateRMFTable(RMFTable* table, const BSplineCurve* curve, int firstSegment) {
+    if (!table || !curve || curve->numSegments != table->numSegments) {
+        fprintf(stderr, "Error: Rotation-minimizing frames were built for a different curve\n");
+        return 0;
+    }
+    if (firstSegment < 1) firstSegment = 1;
+    if (firstSegment > table->numSegments) return 1;
+    return propagate(table, curve, firstSegment);
+}
+
+void bspline_freeRMFTable(RMFTable* table) {
+    if (table) {
+        if (table->rotations) free(table->rotations);
+        free(table);
+    }
+}
+
+// ============================================================================
+// LOOKUP
+// ============================================================================
+
+FrenetFrame bspline_sampleRMF(const RMFTable* table, int segment, float t) {
+    if (segment < 1) {
+        segment = 1;
+        t = 0.0f;
+    }
+    if (segment > table->numSegments) {
+        segment = table->numSegments;
+        t = 1.0f;
+    }
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+
+    int steps = table->samplesPerSegment - 1;
+    float f = t * steps;
+    int i = (int)f;
+    if (i >= steps) i = steps - 1;
+
+    int k = (segment - 1) * steps + i;
+    return keyToFrame(quat_nlerp(table->rotations[k], table->rotations[k + 1], f - i));
+}
+
+void bspline_sampleRMFRotations(const RMFTable* table, const int* segments, const float* ts, int count,
+                                double* keyPositions, Quat* out) {
+    int steps = table->samplesPerSegment - 1;
+
+    // Key k sits at k / steps segments from the curve start
+    for (int i = 0; i < count; i++) {
+        keyPositions[i] = ((double)(segments[i] - 1) + ts[i]) * steps;
+    }
+    quat_sampleKeys(table->rotations, table->numKeys, keyPositions, count, 0, out);
+}
@@ -0,0 +1,117 @@
+#ifndef BSPLINE_RMF_H
+#define BSPLINE_RMF_H
+
+#include "bspline_curve.h"
+#include "quaternion.h"
+
+// ============================================================================
+// ROTATION-MINIMIZING FRAMES (DOUBLE REFLECTION METHOD)
+// Frames are propagated along the curve once and stored as quaternion
+// keys; orientation at runtime is an O(1) interpolated lookup. Unlike the
+// Frenet frame, the normal never flips on straight or inflecting parts.
+// ============================================================================
+
+/**
+ * Baked rotation-minimizing frame track
+ *
+ * Each key is the rotation bspline_applyFrenetFrame would apply for the
+ * frame there (16 bytes per key), neighbours in one hemisphere so they can
+ * be nlerped. Neighbouring segments share their joint key. Memory grows
+ * with samplesPerSegment, so callers pick the density their curve needs.
+ */
+typedef struct {
+    Quat* rotations;        // numKeys rotation keys
+    int numKeys;            // numSegments * (samplesPerSegment - 1) + 1
+    int numSegments;        // Segments of the source curve
+    int samplesPerSegment;  // Samples per segment including both ends
+} RMFTable;
+
+/**
+ * First rotation-minimizing frame of a curve
+ *
+ * The Frenet frame at the curve start, with the usual fallback for
+ * straight starts.
+ *
+ * @param curve Compiled curve
+ * @return Orthonormal frame at segment 1, t = 0
+ */
+FrenetFrame bspline_startRMF(const BSplineCurve* curve);
+
+/**
+ * Carry a rotation-minimizing frame to the next sample (double reflection)
+ *
+ * Lets callers that walk the curve in order propagate frames at their own
+ * sample spacing without a table. Samples should be close enough that the
+ * tangent turns by well under 90 degrees between them.
+ *
+ * @param previous Frame at previousPosition
+ * @param previousPosition Previous sample position
+ * @param position Next sample position
+ * @param tangent Curve tangent at position (any length)
+ * @return Orthonormal frame at position
+ */
+FrenetFrame bspline_stepRMF(FrenetFrame previous, Vec3 previousPosition, Vec3 position, Vec3 tangent);
+
+/**
+ * Build rotation-minimizing frame table
+ *
+ * The first frame is bspline_startRMF; every next frame comes from the
+ * double reflection method (Wang et al. 2008).
+ *
+ * @param curve Compiled curve
+ * @param samplesPerSegment Samples per segment including both ends (>= 2)
+ * @return Newly allocated table (free with bspline_freeRMFTable), or NULL on error
+ */
+RMFTable* bspline_buildRMFTable(const BSplineCurve* curve, int samplesPerSegment);
+
+/**
+ * Re-propagate frames after control points moved
+ *
+ * Every frame depends on the one before it, so all keys from the start of
+ * firstSegment to the curve end are recomputed in place, starting from the
+ * key at the start of firstSegment (which the change did not affect).
+ *
+ * @param table Table built for this curve
+ * @param curve Compiled curve with the new coefficients
+ * @param firstSegment First changed segment (1 to n-3)
+ * @return 1 on success, 0 on error (curve shape differs or out of memory)
+ */
+int bspline_updateRMFTable(RMFTable* table, const BSplineCurve* curve, int firstSegment);
+
+/**
+ * Free rotation-minimizing frame table
+ *
+ * @param table Table to free (NULL is allowed)
+ */
+void bspline_freeRMFTable(RMFTable* table);
+
+/**
+ * Sample rotation-minimizing frame at (segment, t)
+ *
+ * Blends the two nearest keys (nlerp) and turns the rotation back into
+ * a frame, which can be drawn with drawFrenetFrame.
+ *
+ * @param table Frame table
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1]
+ * @return Orthonormal frame (tangent, normal, binormal)
+ */
+FrenetFrame bspline_sampleRMF(const RMFTable* table, int segment, float t);
+
+/**
+ * Rotations of many (segment, t) pairs: one quat_sampleKeys call (nlerp)
+ *
+ * out[i] is the rotation bspline_applyFrenetFrame would apply for the
+ * frame at (segments[i], ts[i]), blended between the two nearest keys.
+ *
+ * @param table Frame table
+ * @param segments Segment indices (1 to n-3)
+ * @param ts Parameters in [0, 1]
+ * @param count Number of lookups
+ * @param keyPositions Scratch array of count doubles
+ * @param out Output rotations
+ */
+void bspline_sampleRMFRotations(const RMFTable* table, const int* segments, const float* ts, int count,
+                                double* keyPositions, Quat* out);
+
+#endif // BSPLINE_RMF_H
@@ -0,0 +1,214 @@
+#include "bspline_storage.h"
+#include "simd_dispatch.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Lane alignment and padding (one AVX register)
+#define LANE_ALIGNMENT 32
+#define LANE_FLOATS 8
+
+// ============================================================================
+// BASIS WEIGHTS
+// ============================================================================
+
+/**
+ * Weights of r_{i-1} .. r_{i+2} at t (rows of T * B_{i,3} / 6):
+ * (1-t)^3 / 6, (3t^3 - 6t^2 + 4) / 6, (-3t^3 + 3t^2 + 3t + 1) / 6, t^3 / 6
+ */
+static void basisWeights(double t, double w[4]) {
+    double s = 1.0 - t, t2 = t * t, t3 = t2 * t;
+    w[0] = s * s * s / 6.0;
+    w[1] = (3.0 * t3 - 6.0 * t2 + 4.0) / 6.0;
+    w[2] = (-3.0 * t3 + 3.0 * t2 + 3.0 * t + 1.0) / 6.0;
+    w[3] = t3 / 6.0;
+}
+
+static void basisWeightsFloat(float t, float w[4]) {
+    float s = 1.0f - t, t2 = t * t, t3 = t2 * t;
+    w[0] = s * s * s / 6.0f;
+    w[1] = (3.0f * t3 - 6.0f * t2 + 4.0f) / 6.0f;
+    w[2] = (-3.0f * t3 + 3.0f * t2 + 3.0f * t + 1.0f) / 6.0f;
+    w[3] = t3 / 6.0f;
+}
+
+// ============================================================================
+// LANE KERNELS (FLOAT SoA)
+// out[i] = w0 lane[i] + w1 lane[i+1] + w2 lane[i+2] + w3 lane[i+3]
+// lane points at r_{i-1} of the first segment. The scalar kernel also
+// finishes the tails the vector kernels leave over ([begin, count)).
+// ============================================================================
+
+static void weightLane_scalar(const float* lane, const float w[4], int begin, int count, float* out) {
+    for (int i = begin; i < count; i++) {
+        const float* r = lane + i;
+        out[i] = w[0] * r[0] + w[1] * r[1] + w[2] * r[2] + w[3] * r[3];
+    }
+}
+
+#if defined(SIMD_X86)
+
+static SIMD_TARGET("avx2,fma")
+void weightLane_avx2(const float* lane, const float w[4], int begin, int count, float* out) {
+    __m256 w0 = _mm256_set1_ps(w[0]), w1 = _mm256_set1_ps(w[1]);
+    __m256 w2 = _mm256_set1_ps(w[2]), w3 = _mm256_set1_ps(w[3]);
+
+    int i = begin;
+    for (; i + 8 <= count; i += 8) {
+        __m256 sum = _mm256_mul_ps(w0, _mm256_loadu_ps(lane + i));
+        sum = _mm256_fmadd_ps(w1, _mm256_loadu_ps(lane + i + 1), sum);
+        sum = _mm256_fmadd_ps(w2, _mm256_loadu_ps(lane + i + 2), sum);
+        sum = _mm256_fmadd_ps(w3, _mm256_loadu_ps(lane + i + 3), sum);
+        _mm256_storeu_ps(out + i, sum);
+    }
+
+    weightLane_scalar(lane, w, i, count, out);
+}
+
+static SIMD_TARGET("sse2")
+void weightLane_sse2(const float* lane, const float w[4], int begin, int count, float* out) {
+    __m128 w0 = _mm_set1_ps(w[0]), w1 = _mm_set1_ps(w[1]);
+    __m128 w2 = _mm_set1_ps(w[2]), w3 = _mm_set1_ps(w[3]);
+
+    int i = begin;
+    for (; i + 4 <= count; i += 4) {
+        __m128 sum = _mm_mul_ps(w0, _mm_loadu_ps(lane + i));
+        sum = _mm_add_ps(sum, _mm_mul_ps(w1, _mm_loadu_ps(lane + i + 1)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(w2, _mm_loadu_ps(lane + i + 2)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(w3, _mm_loadu_ps(lane + i + 3)));
+        _mm_storeu_ps(out + i, sum);
+    }
+
+    weightLane_scalar(lane, w, i, count, out);
+}
+
+#endif
+
+// ============================================================================
+// DISPATCH
+// ============================================================================
+
+typedef void (*LaneKernel)(const float* lane, const float w[4], int begin, int count, float* out);
+
+static pthread_once_t dispatchOnce = PTHREAD_ONCE_INIT;
+static LaneKernel currentKernel = weightLane_scalar;
+
+static void initDispatch(void) {
+#if defined(SIMD_X86)
+    SimdLevel level = simd_cpuLevel();
+    if (level >= SIMD_LEVEL_AVX2_FMA) {
+        currentKernel = weightLane_avx2;
+    } else if (level >= SIMD_LEVEL_SSE2) {
+        currentKernel = weightLane_sse2;
+    }
+#endif
+}
+
+static LaneKernel laneKernel(void) {
+    pthread_once(&dispatchOnce, initDispatch);
+    return currentKernel;
+}
+
+// ============================================================================
+// CREATION
+// ============================================================================
+
+CurveStorage* bspline_createStorage(const Vec3* controlPoints, int numControlPoints, CurvePrecision precision) {
+    if (!controlPoints || numControlPoints < 4) {
+        fprintf(stderr, "Error: Need at least 4 control points for curve storage\n");
+        return NULL;
+    }
+
+    CurveStorage* storage = (CurveStorage*)calloc(1, sizeof(CurveStorage));
+    if (!storage) return NULL;
+    storage->precision = precision;
+    storage->numPoints = numControlPoints;
+    storage->numSegments = bspline_getNumSegments(numControlPoints);
+
+    if (precision == CURVE_PRECISION_DOUBLE) {
+        storage->points = controlPoints;
+        return storage;
+    }
+
+    // Three padded, aligned lanes in one block
+    size_t laneFloats = ((size_t)numControlPoints + LANE_FLOATS - 1) / LANE_FLOATS * LANE_FLOATS;
+    void* block = NULL;
+    if (posix_memalign(&block, LANE_ALIGNMENT, 3 * laneFloats * sizeof(float)) != 0) {
+        fprintf(stderr, "Error: Failed to allocate curve storage\n");
+        free(storage);
+        return NULL;
+    }
+
+    storage->x = (float*)block;
+    storage->y = storage->x + laneFloats;
+    storage->z = storage->y + laneFloats;
+    for (int i = 0; i < numControlPoints; i++) {
+        storage->x[i] = (float)controlPoints[i].x;
+        storage->y[i] = (float)controlPoints[i].y;
+        storage->z[i] = (float)controlPoints[i].z;
+    }
+    return storage;
+}
+
+void bspline_freeStorage(CurveStorage* storage) {
+    if (storage) {
+        if (storage->x) free(storage->x);  // Start of the lane block
+        free(storage);
+    }
+}
+
+// ============================================================================
+// EVALUATION
+// ============================================================================
+
+Vec3 bspline_storagePosition(const CurveStorage* storage, int segment, float t) {
+    int first = segment - 1;
+
+    if (storage->precision == CURVE_PRECISION_DOUBLE) {
+        double w[4];
+        basisWeights(t, w);
+        const Vec3* r = storage->points + first;
+        return (Vec3){
+            w[0] * r[0].x + w[1] * r[1].x + w[2] * r[2].x + w[3] * r[3].x,
+            w[0] * r[0].y + w[1] * r[1].y + w[2] * r[2].y + w[3] * r[3].y,
+            w[0] * r[0].z + w[1] * r[1].z + w[2] * r[2].z + w[3] * r[3].z
+        };
+    }
+
+    float w[4];
+    basisWeightsFloat(t, w);
+    const float* x = storage->x + first;
+    const float* y = storage->y + first;
+    const float* z = storage->z + first;
+    return (Vec3){
+        w[0] * x[0] + w[1] * x[1] + w[2] * x[2] + w[3] * x[3],
+        w[0] * y[0] + w[1] * y[1] + w[2] * y[2] + w[3] * y[3],
+        w[0] * z[0] + w[1] * z[1] + w[2] * z[2] + w[3] * z[3]
+    };
+}
+
+void bspline_storageSampleSegments(const CurveStorage* storage, int firstSegment, int count, float t,
+                                   float* outX, float* outY, float* outZ) {
+    if (!storage || count <= 0 || firstSegment < 1 || firstSegment + count - 1 > storage->numSegments) return;
+
+    int first = firstSegment - 1;
+
+    if (storage->precision == CURVE_PRECISION_DOUBLE) {
+        double w[4];
+        basisWeights(t, w);
+        for (int i = 0; i < count; i++) {
+            const Vec3* r = storage->points + first + i;
+            outX[i] = (float)(w[0] * r[0].x + w[1] * r[1].x + w[2] * r[2].x + w[3] * r[3].x);
+            outY[i] = (float)(w[0] * r[0].y + w[1] * r[1].y + w[2] * r[2].y + w[3] * r[3].y);
+            outZ[i] = (float)(w[0] * r[0].z + w[1] * r[1].z + w[2] * r[2].z + w[3] * r[3].z);
+        }
+        return;
+    }
+
+    float w[4];
+    basisWeightsFloat(t, w);
+    LaneKernel kernel = laneKernel();
+    kernel(storage->x + first, w, 0, count, outX);
+    kernel(storage->y + first, w, 0, count, outY);
+    kernel(storage->z + first, w, 0, count, outZ);
+}
@@ -0,0 +1,84 @@
+#ifndef BSPLINE_STORAGE_H
+#define BSPLINE_STORAGE_H
+
+#include "bspline.h"
+
+// ============================================================================
+// PRECISION-SELECTABLE CONTROL POINT STORAGE
+// DOUBLE keeps the Vec3 array (AoS) and evaluates in double throughout;
+// batch outputs are float arrays, so only the results are rounded.
+// FLOAT converts once to three float lanes (SoA) and evaluates in float:
+// half the memory, and neighbouring control points of one coordinate are
+// contiguous, so SIMD kernels evaluate 4 or 8 consecutive segments per
+// instruction (picked at run time, simd_dispatch.h).
+// ============================================================================
+
+/**
+ * Storage precision and layout
+ */
+typedef enum {
+    CURVE_PRECISION_DOUBLE,  // Vec3 array of doubles (AoS), referenced in place
+    CURVE_PRECISION_FLOAT    // x[], y[], z[] float lanes (SoA), owned
+} CurvePrecision;
+
+/**
+ * Control points in the selected precision
+ */
+typedef struct {
+    CurvePrecision precision;
+    int numPoints;
+    int numSegments;       // numPoints - 3
+    const Vec3* points;    // DOUBLE: caller's array (not owned, may be a mapped file)
+    float* x;              // FLOAT: lanes of one 32-byte aligned allocation (owned)
+    float* y;
+    float* z;
+} CurveStorage;
+
+/**
+ * Create storage from a Vec3 array
+ *
+ * DOUBLE references controlPoints (it must outlive the storage);
+ * FLOAT copies and narrows them.
+ *
+ * @param controlPoints Array of control points
+ * @param numControlPoints Number of control points (at least 4)
+ * @param precision Storage precision
+ * @return Newly allocated storage (free with bspline_freeStorage), or NULL on error
+ */
+CurveStorage* bspline_createStorage(const Vec3* controlPoints, int numControlPoints, CurvePrecision precision);
+
+/**
+ * Free storage (a referenced DOUBLE array is left alone)
+ *
+ * @param storage Storage to free (NULL is allowed)
+ */
+void bspline_freeStorage(CurveStorage* storage);
+
+/**
+ * Evaluate position (equation 1.2) in the storage precision
+ *
+ * @param storage Storage
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1]
+ * @return Position vector on the curve
+ */
+Vec3 bspline_storagePosition(const CurveStorage* storage, int segment, float t);
+
+/**
+ * Evaluate positions of consecutive segments at the same parameter
+ *
+ * out[i] = p_{firstSegment + i}(t). With FLOAT storage the SIMD lanes are
+ * consecutive segments, loaded straight from the coordinate arrays.
+ *
+ * @param storage Storage
+ * @param firstSegment First segment index (1 to n-3)
+ * @param count Number of segments (firstSegment + count - 1 <= n-3)
+ * @param t Parameter in [0, 1]
+ * @param outX Output x coordinates (count floats)
+ * @param outY Output y coordinates (count floats)
+ * @param outZ Output z coordinates (count floats)
+ */
+void bspline_storageSampleSegments(const CurveStorage* storage, int firstSegment, int count, float t,
+                                   float* outX, float* outY, float* outZ);
+
+#endif // BSPLINE_STORAGE_H
@@ -0,0 +1,431 @@
+#include "bspline_stream.h"
+#include "path_file.h"
+#include "file_io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+
+// Text bytes buffered by the reader (also the longest accepted line)
+#define STREAM_TEXT_BUFFER 65536
+
+// Points parsed before the ring buffer lock is taken
+#define STREAM_BATCH_POINTS 256
+
+// streamRead result when bspline_closeStream interrupted the reader
+#define STREAM_CLOSED (-2)
+
+struct PathStream {
+    int fd;
+    int ownsFd;
+    int wakeup[2];             // Pipe; bspline_closeStream writes to wake a blocked reader
+    char* name;                // For error messages
+
+    Vec3* ring;                // capacity slots; point k lives in ring[k % capacity]
+    long capacity;
+    long base;                 // Index of the oldest resident point
+    long count;                // Resident points [base, base + count)
+    int finished;              // Reader is done (end of input or error)
+    int closing;
+
+    pthread_t reader;
+    pthread_mutex_t mutex;
+    pthread_cond_t dataReady;  // Reader appended points or finished
+    pthread_cond_t spaceReady; // Consumer released points or is closing
+};
+
+// ============================================================================
+// READER THREAD
+// ============================================================================
+
+/**
+ * One read() that bspline_closeStream can interrupt
+ *
+ * Waits in poll() on the input and the wakeup pipe, so an idle pipe or
+ * terminal does not keep the reader (and the join in close) blocked.
+ *
+ * @return Bytes read (0 at end of input), -1 on error, STREAM_CLOSED if closing
+ */
+static long streamRead(PathStream* stream, void* buffer, size_t size) {
+    struct pollfd fds[2] = {
+        {stream->fd, POLLIN, 0},
+        {stream->wakeup[0], POLLIN, 0}
+    };
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (fds[1].revents) return STREAM_CLOSED;
+
+        ssize_t n = read(stream->fd, buffer, size);
+        if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+        return (long)n;
+    }
+}
+
+/**
+ * Read until `size` bytes arrived or the input ended
+ *
+ * @return Bytes read (less than size only at end of input), -1 on error, STREAM_CLOSED if closing
+ */
+static long readFully(PathStream* stream, void* buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        long n = streamRead(stream, (char*)buffer + done, size - done);
+        if (n < 0) return n;
+        if (n == 0) break;
+        done += (size_t)n;
+    }
+    return (long)done;
+}
+
+/**
+ * Append points to the ring, waiting for the consumer to make room
+ *
+ * @return 1 on success, 0 if the stream is closing
+ */
+static int publishPoints(PathStream* stream, const Vec3* points, int count) {
+    pthread_mutex_lock(&stream->mutex);
+    for (int i = 0; i < count; i++) {
+        while (stream->count == stream->capacity && !stream->closing) {
+            pthread_cond_broadcast(&stream->dataReady);
+            pthread_cond_wait(&stream->spaceReady, &stream->mutex);
+        }
+        if (stream->closing) {
+            pthread_mutex_unlock(&stream->mutex);
+            return 0;
+        }
+        stream->ring[(stream->base + stream->count) % stream->capacity] = points[i];
+        stream->count++;
+    }
+    pthread_cond_broadcast(&stream->dataReady);
+    pthread_mutex_unlock(&stream->mutex);
+    return 1;
+}
+
+/**
+ * Binary path format: header (first 8 bytes already read), then points
+ */
+static void readBinary(PathStream* stream, const char* magic) {
+    PathFileHeader h;
+    memcpy(h.magic, magic, 8);
+    long got = readFully(stream, (char*)&h + 8, sizeof(h) - 8);
+    if (got == STREAM_CLOSED) return;
+    if (got != (long)(sizeof(h) - 8) ||
+        h.byteOrder != PATHFILE_BYTE_ORDER || h.version != PATHFILE_VERSION ||
+        (h.precision != PATH_PRECISION_FLOAT64 && h.precision != PATH_PRECISION_FLOAT32) ||
+        h.pointsOffset < sizeof(h)) {
+        fprintf(stderr, "Error: %s: invalid binary path header\n", stream->name);
+        return;
+    }
+    if (!pathfile_checkCurveType(&h, stream->name)) return;
+
+    // Knots follow the points, so their spacing could only be checked after
+    // every point was already used; a pipe cannot seek ahead to them
+    if (h.numKnots > 0) {
+        fprintf(stderr, "Error: %s: paths with a knot vector cannot be streamed\n", stream->name);
+        return;
+    }
+
+    // Skip to the point array (pipes cannot seek)
+    char skip[256];
+    for (uint64_t left = h.pointsOffset - sizeof(h); left > 0; ) {
+        size_t chunk = left < sizeof(skip) ? (size_t)left : sizeof(skip);
+        got = readFully(stream, skip, chunk);
+        if (got == STREAM_CLOSED) return;
+        if (got != (long)chunk) {
+            fprintf(stderr, "Error: %s: truncated binary path\n", stream->name);
+            return;
+        }
+        left -= chunk;
+    }
+
+    int isFloat = (h.precision == PATH_PRECISION_FLOAT32);
+    size_t stride = isFloat ? 3 * sizeof(float) : sizeof(Vec3);
+    Vec3 batch[STREAM_BATCH_POINTS];
+    float raw[3 * STREAM_BATCH_POINTS];
+
+    for (uint64_t left = h.numPoints; left > 0; ) {
+        int n = left < STREAM_BATCH_POINTS ? (int)left : STREAM_BATCH_POINTS;
+        void* target = isFloat ? (void*)raw : (void*)batch;
+        got = readFully(stream, target, n * stride);
+        if (got == STREAM_CLOSED) return;
+        if (got != (long)(n * stride)) {
+            fprintf(stderr, "Error: %s: truncated binary path\n", stream->name);
+            return;
+        }
+        if (isFloat) {
+            for (int i = 0; i < n; i++) {
+                batch[i] = (Vec3){raw[3 * i], raw[3 * i + 1], raw[3 * i + 2]};
+            }
+        }
+        if (!publishPoints(stream, batch, n)) return;
+        left -= (uint64_t)n;
+    }
+}
+
+/**
+ * Text format: complete lines are parsed as soon as they arrive
+ */
+static void readText(PathStream* stream, const char* prefix, size_t prefixLength) {
+    char* text = (char*)malloc(STREAM_TEXT_BUFFER);
+    if (!text) return;
+    memcpy(text, prefix, prefixLength);
+    size_t length = prefixLength;
+    int line = 1;
+    int atEnd = 0;
+
+    Vec3 batch[STREAM_BATCH_POINTS];
+    int numBatch = 0;
+
+    while (!atEnd) {
+        long n = streamRead(stream, text + length, STREAM_TEXT_BUFFER - length);
+        if (n == STREAM_CLOSED) break;
+        if (n < 0) {
+            fprintf(stderr, "Error: %s: read failed\n", stream->name);
+            break;
+        }
+        if (n == 0) atEnd = 1;
+        length += (size_t)n;
+
+        // Parse every complete line (and the unterminated last one at end of input)
+        const char* p = text;
+        const char* end = text + length;
+        int failed = 0;
+        for (;;) {
+            const char* lineEnd = (const char*)memchr(p, '\n', (size_t)(end - p));
+            if (!lineEnd) {
+                if (!atEnd || p == end) break;
+                lineEnd = end;
+            }
+
+            Vec3 point;
+            const char* message;
+            int parsed = parseControlPointLine(p, lineEnd, &point, &message);
+            if (parsed < 0) {
+                fprintf(stderr, "Error: %s:%d: %s\n", stream->name, line, message);
+                failed = 1;
+                break;
+            }
+            if (parsed) batch[numBatch++] = point;
+            p = (lineEnd < end) ? lineEnd + 1 : end;
+            line++;
+
+            if (numBatch == STREAM_BATCH_POINTS) {
+                if (!publishPoints(stream, batch, numBatch)) failed = 1;
+                numBatch = 0;
+                if (failed) break;
+            }
+        }
+        if (failed) break;
+
+        // Points of this read become visible right away (slow writers, pipes)
+        if (numBatch > 0) {
+            if (!publishPoints(stream, batch, numBatch)) break;
+            numBatch = 0;
+        }
+
+        length = (size_t)(end - p);
+        memmove(text, p, length);
+        if (length == STREAM_TEXT_BUFFER) {
+            fprintf(stderr, "Error: %s:%d: line too long\n", stream->name, line);
+            break;
+        }
+    }
+
+    free(text);
+}
+
+static void* readerMain(void* arg) {
+    PathStream* stream = (PathStream*)arg;
+
+    char magic[8];
+    long n = readFully(stream, magic, sizeof(magic));
+    if (n == (long)sizeof(magic) && memcmp(magic, PATHFILE_MAGIC, 8) == 0) {
+        readBinary(stream, magic);
+    } else if (n >= 0) {
+        readText(stream, magic, (size_t)n);
+    } else if (n != STREAM_CLOSED) {
+        fprintf(stderr, "Error: %s: read failed\n", stream->name);
+    }
+
+    pthread_mutex_lock(&stream->mutex);
+    stream->finished = 1;
+    pthread_cond_broadcast(&stream->dataReady);
+    pthread_mutex_unlock(&stream->mutex);
+    return NULL;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+PathStream* bspline_openStream(const char* filename, int windowSize) {
+    if (!filename || windowSize < 8) {
+        fprintf(stderr, "Error: Stream window must hold at least 8 control points\n");
+        return NULL;
+    }
+
+    int isStdin = strcmp(filename, "-") == 0;
+    int fd = isStdin ? STDIN_FILENO : open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open path stream '%s'\n", filename);
+        return NULL;
+    }
+
+    PathStream* stream = (PathStream*)calloc(1, sizeof(PathStream));
+    if (stream) {
+        stream->ring = (Vec3*)malloc((size_t)windowSize * sizeof(Vec3));
+        stream->name = strdup(isStdin ? "<stdin>" : filename);
+        if (pipe(stream->wakeup) != 0) stream->wakeup[0] = stream->wakeup[1] = -1;
+    }
+    if (!stream || !stream->ring || !stream->name || stream->wakeup[0] < 0) {
+        fprintf(stderr, "Error: Failed to allocate path stream\n");
+        if (stream) {
+            if (stream->wakeup[0] >= 0) {
+                close(stream->wakeup[0]);
+                close(stream->wakeup[1]);
+            }
+            free(stream->ring);
+            free(stream->name);
+            free(stream);
+        }
+        if (!isStdin) close(fd);
+        return NULL;
+    }
+
+    stream->fd = fd;
+    stream->ownsFd = !isStdin;
+    stream->capacity = windowSize;
+    pthread_mutex_init(&stream->mutex, NULL);
+    pthread_cond_init(&stream->dataReady, NULL);
+    pthread_cond_init(&stream->spaceReady, NULL);
+
+    if (pthread_create(&stream->reader, NULL, readerMain, stream) != 0) {
+        fprintf(stderr, "Error: Failed to start path stream reader\n");
+        pthread_mutex_destroy(&stream->mutex);
+        pthread_cond_destroy(&stream->dataReady);
+        pthread_cond_destroy(&stream->spaceReady);
+        if (stream->ownsFd) close(fd);
+        close(stream->wakeup[0]);
+        close(stream->wakeup[1]);
+        free(stream->ring);
+        free(stream->name);
+        free(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
+void bspline_closeStream(PathStream* stream) {
+    if (!stream) return;
+
+    pthread_mutex_lock(&stream->mutex);
+    stream->closing = 1;
+    pthread_cond_broadcast(&stream->spaceReady);
+    pthread_mutex_unlock(&stream->mutex);
+
+    // Wake a reader waiting for input; it is never read, so one byte stays signalled
+    char byte = 0;
+    while (write(stream->wakeup[1], &byte, 1) < 0 && errno == EINTR) {}
+    pthread_join(stream->reader, NULL);
+
+    pthread_mutex_destroy(&stream->mutex);
+    pthread_cond_destroy(&stream->dataReady);
+    pthread_cond_destroy(&stream->spaceReady);
+    if (stream->ownsFd) close(stream->fd);
+    close(stream->wakeup[0]);
+    close(stream->wakeup[1]);
+    free(stream->ring);
+    free(stream->name);
+    free(stream);
+}
+
+/**
+ * Drop resident points before `first` (caller holds the mutex)
+ */
+static void releaseBefore(PathStream* stream, long first) {
+    long drop = first - stream->base;
+    if (drop <= 0) return;
+    if (drop > stream->count) drop = stream->count;
+    if (drop == 0) return;
+
+    stream->base += drop;
+    stream->count -= drop;
+    pthread_cond_signal(&stream->spaceReady);
+}
+
+int bspline_streamRequest(PathStream* stream, int segment, int wait) {
+    if (!stream || segment < 1) return -1;
+
+    long first = segment - 1;  // r_{i-1} .. r_{i+2}, 0-based
+    long last = segment + 2;
+
+    pthread_mutex_lock(&stream->mutex);
+    if (first < stream->base) {
+        pthread_mutex_unlock(&stream->mutex);
+        fprintf(stderr, "Error: Segment %d was already released from the stream window\n", segment);
+        return -1;
+    }
+
+    int result = 1;
+    releaseBefore(stream, first);
+    while (stream->base + stream->count <= last) {
+        if (stream->finished) {
+            result = -1;
+            break;
+        }
+        if (!wait) {
+            result = 0;
+            break;
+        }
+        pthread_cond_wait(&stream->dataReady, &stream->mutex);
+        releaseBefore(stream, first);  // Skipped-over points arrived meanwhile
+    }
+    pthread_mutex_unlock(&stream->mutex);
+
+    return result;
+}
+
+/**
+ * Copy a resident segment's four control points
+ *
+ * Resident slots are never written by the reader, so no lock is needed.
+ */
+static void segmentPoints(const PathStream* stream, int segment, Vec3 r[4]) {
+    for (int k = 0; k < 4; k++) {
+        r[k] = stream->ring[(segment - 1 + k) % stream->capacity];
+    }
+}
+
+Vec3 bspline_streamPosition(PathStream* stream, int segment, float t) {
+    Vec3 r[4];
+    segmentPoints(stream, segment, r);
+    return bspline_evaluatePosition(r, 1, t);
+}
+
+Vec3 bspline_streamTangent(PathStream* stream, int segment, float t) {
+    Vec3 r[4];
+    segmentPoints(stream, segment, r);
+    return bspline_evaluateTangent(r, 1, t);
+}
+
+long bspline_streamPointsRead(PathStream* stream) {
+    pthread_mutex_lock(&stream->mutex);
+    long read = stream->base + stream->count;
+    pthread_mutex_unlock(&stream->mutex);
+    return read;
+}
+
+int bspline_streamFinished(PathStream* stream) {
+    pthread_mutex_lock(&stream->mutex);
+    int finished = stream->finished;
+    pthread_mutex_unlock(&stream->mutex);
+    return finished;
+}
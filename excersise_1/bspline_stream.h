@@ -0,0 +1,85 @@
+#ifndef BSPLINE_STREAM_H
+#define BSPLINE_STREAM_H
+
+#include "bspline.h"
+
+// ============================================================================
+// SLIDING-WINDOW STREAMING TRAVERSAL
+// Segment i only needs control points r_{i-1} .. r_{i+2}. A background
+// reader fills a fixed-size ring buffer from a file or pipe (text or binary
+// path format) and keeps it ahead of the traversal; points behind the
+// current segment are released. Memory use is constant, so paths larger
+// than RAM - or still being written by another process - can be followed.
+// ============================================================================
+
+typedef struct PathStream PathStream;
+
+/**
+ * Open streaming path
+ *
+ * @param filename Text or binary path file, FIFO, or "-" for standard input
+ * @param windowSize Ring buffer capacity in control points (>= 8)
+ * @return Newly allocated stream (close with bspline_closeStream), or NULL on error
+ */
+PathStream* bspline_openStream(const char* filename, int windowSize);
+
+/**
+ * Stop the reader and free the stream
+ *
+ * A reader waiting for input on an idle pipe or terminal is woken up, so
+ * this returns promptly even if the writer never sends more data.
+ *
+ * @param stream Stream to close (NULL is allowed)
+ */
+void bspline_closeStream(PathStream* stream);
+
+/**
+ * Make a segment's control points resident
+ *
+ * Releases all points before r_{segment-1}, so segments must be requested
+ * in non-decreasing order. Anything behind the window is gone.
+ *
+ * @param stream Stream
+ * @param segment Segment index (1, 2, ...)
+ * @param wait 1 to block until the points arrive, 0 to return immediately
+ * @return 1 if the segment is resident, 0 if not (yet), -1 if the path ends before it
+ */
+int bspline_streamRequest(PathStream* stream, int segment, int wait);
+
+/**
+ * Evaluate position on a resident segment
+ *
+ * @param stream Stream
+ * @param segment Segment index (requested successfully)
+ * @param t Parameter in [0, 1]
+ * @return Position vector on the curve
+ */
+Vec3 bspline_streamPosition(PathStream* stream, int segment, float t);
+
+/**
+ * Evaluate tangent on a resident segment
+ *
+ * @param stream Stream
+ * @param segment Segment index (requested successfully)
+ * @param t Parameter in [0, 1]
+ * @return Tangent vector (unnormalized)
+ */
+Vec3 bspline_streamTangent(PathStream* stream, int segment, float t);
+
+/**
+ * Number of control points read so far (including released ones)
+ *
+ * @param stream Stream
+ * @return Points read
+ */
+long bspline_streamPointsRead(PathStream* stream);
+
+/**
+ * Check whether the reader reached the end of the input
+ *
+ * @param stream Stream
+ * @return 1 after end of input or a read/parse error, 0 while more may come
+ */
+int bspline_streamFinished(PathStream* stream);
+
+#endif // BSPLINE_STREAM_H
@@ -0,0 +1,128 @@
+#include "bspline_tessellate.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// ============================================================================
+// FORWARD DIFFERENCING
+// ============================================================================
+
+int bspline_tessellationVertexCount(int numSegments, int samplesPerSegment) {
+    if (numSegments <= 0 || samplesPerSegment < 2) return 0;
+    return numSegments * (samplesPerSegment - 1) + 1;
+}
+
+/**
+ * Tessellate one segment with forward differencing
+ *
+ * For p(t) = a t^3 + b t^2 + c t + d and step h the initial differences are:
+ *   d1 = a h^3 +   b h^2 + c h
+ *   d2 = 6a h^3 + 2b h^2
+ *   d3 = 6a h^3
+ * Differences are accumulated in double to keep long runs accurate.
+ */
+void bspline_tessellateSegment(const BSplineCurve* curve, int segment, int samplesPerSegment,
+                               float* outVertices) {
+    if (!curve || !outVertices || samplesPerSegment < 2) return;
+    if (segment < 1 || segment > curve->numSegments) return;
+
+    const Vec3* k = curve->segments[segment - 1].pos;
+    double h = 1.0 / (double)(samplesPerSegment - 1);
+    double h2 = h * h;
+    double h3 = h2 * h;
+
+    double p[3]  = {k[3].x, k[3].y, k[3].z};
+    double d1[3] = {
+        k[0].x * h3 + k[1].x * h2 + k[2].x * h,
+        k[0].y * h3 + k[1].y * h2 + k[2].y * h,
+        k[0].z * h3 + k[1].z * h2 + k[2].z * h
+    };
+    double d2[3] = {
+        6.0 * k[0].x * h3 + 2.0 * k[1].x * h2,
+        6.0 * k[0].y * h3 + 2.0 * k[1].y * h2,
+        6.0 * k[0].z * h3 + 2.0 * k[1].z * h2
+    };
+    double d3[3] = {6.0 * k[0].x * h3, 6.0 * k[0].y * h3, 6.0 * k[0].z * h3};
+
+    float* out = outVertices;
+    for (int i = 0; i < samplesPerSegment - 1; i++) {
+        out[0] = (float)p[0];
+        out[1] = (float)p[1];
+        out[2] = (float)p[2];
+        out += 3;
+
+        for (int c = 0; c < 3; c++) {
+            p[c] += d1[c];
+            d1[c] += d2[c];
+            d2[c] += d3[c];
+        }
+    }
+
+    // Exact end point p(1) = a + b + c + d
+    out[0] = (float)(k[0].x + k[1].x + k[2].x + k[3].x);
+    out[1] = (float)(k[0].y + k[1].y + k[2].y + k[3].y);
+    out[2] = (float)(k[0].z + k[1].z + k[2].z + k[3].z);
+}
+
+int bspline_tessellateCurve(const BSplineCurve* curve, int samplesPerSegment, float* outVertices) {
+    if (!curve || !outVertices || samplesPerSegment < 2) return 0;
+
+    // Segment 1 writes all its samples; every later segment starts at the
+    // previous end point (C0 joint), so its first sample overwrites that vertex.
+    int stride = samplesPerSegment - 1;
+    for (int seg = 1; seg <= curve->numSegments; seg++) {
+        bspline_tessellateSegment(curve, seg, samplesPerSegment, outVertices + 3 * (seg - 1) * stride);
+    }
+
+    return bspline_tessellationVertexCount(curve->numSegments, samplesPerSegment);
+}
+
+// ============================================================================
+// TESSELLATION BUFFER MANAGEMENT
+// ============================================================================
+
+void bspline_initTessellation(BSplineTessellation* tess, float* buffer, int capacity) {
+    if (!tess) return;
+
+    tess->vertices = buffer;
+    tess->numVertices = 0;
+    tess->capacity = buffer ? capacity : 0;
+    tess->samplesPerSegment = 0;
+    tess->ownsVertices = buffer ? 0 : 1;
+}
+
+int bspline_buildTessellation(BSplineTessellation* tess, const BSplineCurve* curve, int samplesPerSegment) {
+    if (!tess || !curve || samplesPerSegment < 2) return 0;
+
+    int needed = bspline_tessellationVertexCount(curve->numSegments, samplesPerSegment);
+
+    if (needed > tess->capacity) {
+        if (!tess->ownsVertices) {
+            fprintf(stderr, "Error: Tessellation buffer too small (%d vertices, need %d)\n",
+                    tess->capacity, needed);
+            return 0;
+        }
+
+        float* grown = (float*)realloc(tess->vertices, (size_t)needed * 3 * sizeof(float));
+        if (!grown) {
+            fprintf(stderr, "Error: Failed to allocate tessellation buffer\n");
+            return 0;
+        }
+        tess->vertices = grown;
+        tess->capacity = needed;
+    }
+
+    tess->numVertices = bspline_tessellateCurve(curve, samplesPerSegment, tess->vertices);
+    tess->samplesPerSegment = samplesPerSegment;
+    return 1;
+}
+
+void bspline_freeTessellation(BSplineTessellation* tess) {
+    if (!tess) return;
+
+    if (tess->ownsVertices && tess->vertices) {
+        free(tess->vertices);
+    }
+    tess->vertices = NULL;
+    tess->numVertices = 0;
+    tess->capacity = 0;
+}
@@ -0,0 +1,90 @@
+#ifndef BSPLINE_TESSELLATE_H
+#define BSPLINE_TESSELLATE_H
+
+#include "bspline_curve.h"
+
+// ============================================================================
+// FORWARD-DIFFERENCING TESSELLATOR
+// Uniform samples of a cubic segment with three additions per point:
+//   p += d1;  d1 += d2;  d2 += d3
+// ============================================================================
+
+/**
+ * Tessellated curve as one continuous line strip
+ *
+ * Vertices are interleaved floats (x, y, z), ready for glVertexPointer.
+ * Neighbouring segments share their joint vertex, so the strip holds
+ * numSegments * (samplesPerSegment - 1) + 1 vertices.
+ */
+typedef struct {
+    float* vertices;        // 3 floats per vertex
+    int numVertices;        // Vertices currently stored
+    int capacity;           // Allocated vertices
+    int samplesPerSegment;  // Samples per segment including both ends
+    int ownsVertices;       // 1 if vertices was allocated by the tessellator
+} BSplineTessellation;
+
+/**
+ * Number of vertices needed to tessellate a whole curve
+ *
+ * @param numSegments Number of segments
+ * @param samplesPerSegment Samples per segment including both ends (>= 2)
+ * @return Vertex count of the shared-joint line strip
+ */
+int bspline_tessellationVertexCount(int numSegments, int samplesPerSegment);
+
+/**
+ * Tessellate one segment with forward differencing
+ *
+ * Writes samplesPerSegment vertices for t = 0, h, 2h, ..., 1 where
+ * h = 1 / (samplesPerSegment - 1). The last vertex is evaluated exactly
+ * so accumulated rounding never opens a gap at the segment joint.
+ *
+ * @param curve Compiled curve
+ * @param segment Segment index (1 to n-3)
+ * @param samplesPerSegment Number of samples (>= 2)
+ * @param outVertices Output buffer with room for 3 * samplesPerSegment floats
+ */
+void bspline_tessellateSegment(const BSplineCurve* curve, int segment, int samplesPerSegment,
+                               float* outVertices);
+
+/**
+ * Tessellate whole curve into a caller-owned vertex buffer
+ *
+ * @param curve Compiled curve
+ * @param samplesPerSegment Samples per segment including both ends (>= 2)
+ * @param outVertices Buffer with room for 3 * bspline_tessellationVertexCount(...) floats
+ * @return Number of vertices written
+ */
+int bspline_tessellateCurve(const BSplineCurve* curve, int samplesPerSegment, float* outVertices);
+
+/**
+ * Initialize tessellation with an optional caller-owned buffer
+ *
+ * @param tess Tessellation to initialize
+ * @param buffer Caller-owned vertex buffer, or NULL to let the tessellator allocate
+ * @param capacity Buffer capacity in vertices (ignored if buffer is NULL)
+ */
+void bspline_initTessellation(BSplineTessellation* tess, float* buffer, int capacity);
+
+/**
+ * (Re)build tessellation for a curve
+ *
+ * Grows the internal buffer if needed. A caller-owned buffer is never
+ * reallocated - the build fails if it is too small.
+ *
+ * @param tess Tessellation (initialized with bspline_initTessellation)
+ * @param curve Compiled curve
+ * @param samplesPerSegment Samples per segment including both ends (>= 2)
+ * @return 1 on success, 0 on error
+ */
+int bspline_buildTessellation(BSplineTessellation* tess, const BSplineCurve* curve, int samplesPerSegment);
+
+/**
+ * Release tessellation memory (caller-owned buffers are left alone)
+ *
+ * @param tess Tessellation to free
+ */
+void bspline_freeTessellation(BSplineTessellation* tess);
+
+#endif // BSPLINE_TESSELLATE_H
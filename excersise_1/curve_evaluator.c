@@ -0,0 +1,51 @@
+#include "curve_evaluator.h"
+
+// ============================================================================
+// ADAPTERS
+// Thin wrappers so every backend matches CurveSegmentFunc exactly.
+// ============================================================================
+
+static Vec3 controlPointsPosition(const void* curve, int segment, float t) {
+    return bspline_evaluatePosition((const Vec3*)curve, segment, t);
+}
+
+static Vec3 controlPointsTangent(const void* curve, int segment, float t) {
+    return bspline_evaluateTangent((const Vec3*)curve, segment, t);
+}
+
+static Vec3 compiledPosition(const void* curve, int segment, float t) {
+    return bspline_curvePosition((const BSplineCurve*)curve, segment, t);
+}
+
+static Vec3 compiledTangent(const void* curve, int segment, float t) {
+    return bspline_curveTangent((const BSplineCurve*)curve, segment, t);
+}
+
+static Vec3 nurbsPosition(const void* curve, int segment, float t) {
+    return nurbs_evaluatePosition((const NurbsCurve*)curve, segment, t);
+}
+
+static Vec3 nurbsTangent(const void* curve, int segment, float t) {
+    return nurbs_evaluateTangent((const NurbsCurve*)curve, segment, t);
+}
+
+CurveEvaluator curve_fromControlPoints(const Vec3* controlPoints, int numControlPoints) {
+    return (CurveEvaluator){
+        controlPoints, bspline_getNumSegments(numControlPoints),
+        controlPointsPosition, controlPointsTangent
+    };
+}
+
+CurveEvaluator curve_fromCompiled(const BSplineCurve* curve) {
+    return (CurveEvaluator){
+        curve, curve ? curve->numSegments : 0,
+        compiledPosition, compiledTangent
+    };
+}
+
+CurveEvaluator curve_fromNurbs(const NurbsCurve* curve) {
+    return (CurveEvaluator){
+        curve, curve ? curve->numSegments : 0,
+        nurbsPosition, nurbsTangent
+    };
+}
@@ -0,0 +1,76 @@
+#ifndef CURVE_EVALUATOR_H
+#define CURVE_EVALUATOR_H
+
+#include "bspline.h"
+#include "bspline_curve.h"
+#include "nurbs.h"
+
+// ============================================================================
+// COMMON CURVE EVALUATION INTERFACE
+// Uniform control points, compiled uniform curves and NURBS curves all
+// answer the same (segment, t) queries, segments numbered 1..numSegments.
+// ============================================================================
+
+// Segment query: position or tangent at (segment, t)
+typedef Vec3 (*CurveSegmentFunc)(const void* curve, int segment, float t);
+
+/**
+ * Curve behind the (segment, t) evaluation interface
+ */
+typedef struct {
+    const void* curve;          // Source data (not owned)
+    int numSegments;            // Valid segments are 1..numSegments
+    CurveSegmentFunc position;  // Position on segment
+    CurveSegmentFunc tangent;   // Tangent on segment (derivative w.r.t. t)
+} CurveEvaluator;
+
+/**
+ * Evaluator over a raw control point array (bspline_evaluatePosition/Tangent)
+ *
+ * @param controlPoints Array of control points (must outlive the evaluator)
+ * @param numControlPoints Number of control points
+ * @return Evaluator
+ */
+CurveEvaluator curve_fromControlPoints(const Vec3* controlPoints, int numControlPoints);
+
+/**
+ * Evaluator over a compiled uniform curve (bspline_curvePosition/Tangent)
+ *
+ * @param curve Compiled curve (must outlive the evaluator)
+ * @return Evaluator
+ */
+CurveEvaluator curve_fromCompiled(const BSplineCurve* curve);
+
+/**
+ * Evaluator over a NURBS curve (nurbs_evaluatePosition/Tangent)
+ *
+ * @param curve NURBS curve (must outlive the evaluator)
+ * @return Evaluator
+ */
+CurveEvaluator curve_fromNurbs(const NurbsCurve* curve);
+
+/**
+ * Evaluate position through the interface
+ *
+ * @param evaluator Curve evaluator
+ * @param segment Segment index (1 to numSegments)
+ * @param t Parameter in [0, 1]
+ * @return Position on the curve
+ */
+static inline Vec3 curve_position(const CurveEvaluator* evaluator, int segment, float t) {
+    return evaluator->position(evaluator->curve, segment, t);
+}
+
+/**
+ * Evaluate tangent through the interface
+ *
+ * @param evaluator Curve evaluator
+ * @param segment Segment index (1 to numSegments)
+ * @param t Parameter in [0, 1]
+ * @return Tangent vector (unnormalized)
+ */
+static inline Vec3 curve_tangent(const CurveEvaluator* evaluator, int segment, float t) {
+    return evaluator->tangent(evaluator->curve, segment, t);
+}
+
+#endif // CURVE_EVALUATOR_H
@@ -2,6 +2,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Large loaded paths are only listed up to this many points
+#define MAX_PRINTED_POINTS 32
 
 // ============================================================================
 // CONTROL POINT GENERATION AND DISPLAY
@@ -50,8 +57,244 @@ void printControlPoints(const Vec3* points, int count) {
     }
     
     printf("=== Control Points (%d) ===\n", count);
-    for (int i = 0; i < count; i++) {
+    int shown = (count > MAX_PRINTED_POINTS) ? MAX_PRINTED_POINTS : count;
+    for (int i = 0; i < shown; i++) {
         printf("  P%d: (%.2f, %.2f, %.2f)\n", i, points[i].x, points[i].y, points[i].z);
     }
+    if (shown < count) {
+        printf("  ... (%d more)\n", count - shown);
+    }
     printf("===========================\n");
 }
+
+// ============================================================================
+// CONTROL POINT LOADING
+// ============================================================================
+
+// Exact powers of ten (every one is representable in a double)
+static const double POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * Parse one decimal number starting at *cursor (no leading whitespace)
+ *
+ * Accepts [+-]digits[.digits][(e|E)[+-]digits]. Mantissas of up to 15
+ * significant digits with a decimal exponent within +-22 are converted
+ * exactly with a single multiply or divide; anything else (very long or
+ * huge numbers, rare in path files) falls back to strtod on a terminated copy of the whole number.
+ *
+ * @return 1 and advances *cursor on success, 0 if no number starts here
+ */
+static int scanNumber(const char** cursor, const char* end, double* out) {
+    const char* p = *cursor;
+    int negative = 0;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    unsigned long long mantissa = 0;
+    int digits = 0;      // Significant digits kept in mantissa
+    int exponent = 0;    // Decimal exponent applied to mantissa
+    int seenDigit = 0;
+
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (unsigned long long)(*p - '0');
+            if (mantissa) digits++;
+        } else {
+            exponent++;  // Dropped digit still scales the value
+        }
+        seenDigit = 1;
+        p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (unsigned long long)(*p - '0');
+                if (mantissa) digits++;
+                exponent--;
+            }
+            seenDigit = 1;
+            p++;
+        }
+    }
+    if (!seenDigit) return 0;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char* e = p + 1;
+        int expNegative = 0;
+        if (e < end && (*e == '-' || *e == '+')) {
+            expNegative = (*e == '-');
+            e++;
+        }
+        if (e < end && *e >= '0' && *e <= '9') {
+            int value = 0;
+            while (e < end && *e >= '0' && *e <= '9') {
+                if (value < 100000) value = value * 10 + (*e - '0');
+                e++;
+            }
+            exponent += expNegative ? -value : value;
+            p = e;
+        }
+    }
+
+    double result;
+    if (digits <= 15 && exponent >= -22 && exponent <= 22) {
+        result = (double)mantissa;
+        result = (exponent >= 0) ? result * POW10[exponent] : result / POW10[-exponent];
+    } else {
+        // The mapping is not terminated, so strtod needs a terminated copy;
+        // numbers too long for the stack buffer are copied to the heap
+        char buffer[128];
+        size_t length = (size_t)(p - *cursor);
+        char* copy = (length < sizeof(buffer)) ? buffer : (char*)malloc(length + 1);
+        if (!copy) return 0;
+        memcpy(copy, *cursor, length);
+        copy[length] = '\0';
+        result = strtod(copy, NULL);
+        if (copy != buffer) free(copy);
+        negative = 0;  // strtod saw the sign
+    }
+
+    *out = negative ? -result : result;
+    *cursor = p;
+    return 1;
+}
+
+int parseControlPointLine(const char* line, const char* end, Vec3* outPoint, const char** outError) {
+    const char* p = line;
+
+    // Skip leading blanks
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+
+    // Blank line or comment
+    if (p == end || *p == '#') return 0;
+
+    static const char* const missing[3] = {
+        "expected x coordinate", "expected y coordinate", "expected z coordinate"
+    };
+    double v[3];
+    for (int k = 0; k < 3; k++) {
+        if (k > 0) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) p++;
+        }
+        if (!scanNumber(&p, end, &v[k])) {
+            *outError = missing[k];
+            return -1;
+        }
+
+        // A number ends at a separator, a comment or the end of the line
+        // ("1-2-3" or "1.5.2" are not several numbers)
+        if (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != ',' && *p != '#') {
+            *outError = "invalid number";
+            return -1;
+        }
+    }
+
+    // Only blanks or a comment may follow the three coordinates
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == ',')) p++;
+    if (p < end && *p != '#') {
+        *outError = "unexpected characters after coordinates";
+        return -1;
+    }
+
+    outPoint->x = v[0];
+    outPoint->y = v[1];
+    outPoint->z = v[2];
+    return 1;
+}
+
+Vec3* loadControlPoints(const char* filename, int* outCount) {
+    *outCount = 0;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open control point file '%s'\n", filename);
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        fprintf(stderr, "Error: Cannot stat control point file '%s'\n", filename);
+        close(fd);
+        return NULL;
+    }
+    if (info.st_size == 0) {
+        fprintf(stderr, "Error: Control point file '%s' is empty\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)info.st_size;
+    const char* data = (const char*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (data == (const char*)MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map control point file '%s'\n", filename);
+        return NULL;
+    }
+    madvise((void*)data, size, MADV_SEQUENTIAL);
+
+    // Guess from file size ("1.0 2.0 3.0\n" is ~12 bytes), grow if needed
+    size_t capacity = size / 12 + 16;
+    size_t count = 0;
+    Vec3* points = (Vec3*)malloc(capacity * sizeof(Vec3));
+
+    const char* p = data;
+    const char* end = data + size;
+    int line = 1;
+    int failed = (points == NULL);
+
+    while (p < end && !failed) {
+        const char* lineEnd = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!lineEnd) lineEnd = end;
+
+        Vec3 point;
+        const char* message;
+        int parsed = parseControlPointLine(p, lineEnd, &point, &message);
+        if (parsed < 0) {
+            fprintf(stderr, "Error: %s:%d: %s\n", filename, line, message);
+            failed = 1;
+            break;
+        }
+        p = lineEnd + 1;
+        line++;
+        if (!parsed) continue;
+
+        if (count == capacity) {
+            capacity *= 2;
+            Vec3* grown = (Vec3*)realloc(points, capacity * sizeof(Vec3));
+            if (!grown) {
+                failed = 1;
+                break;
+            }
+            points = grown;
+        }
+        points[count++] = point;
+
+        if (count > 0x7fffffff) {
+            fprintf(stderr, "Error: %s: too many control points\n", filename);
+            failed = 1;
+        }
+    }
+
+    munmap((void*)data, size);
+
+    if (failed || count == 0) {
+        if (!failed) fprintf(stderr, "Error: No control points in '%s'\n", filename);
+        else if (!points) fprintf(stderr, "Error: Out of memory loading '%s'\n", filename);
+        free(points);
+        return NULL;
+    }
+
+    // Give back the unused part of the size estimate
+    Vec3* trimmed = (Vec3*)realloc(points, count * sizeof(Vec3));
+    if (trimmed) points = trimmed;
+
+    *outCount = (int)count;
+    printf("Loaded %d control points from %s\n", *outCount, filename);
+    return points;
+}
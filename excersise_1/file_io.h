@@ -4,7 +4,7 @@
 #include "bspline.h"
 
 // ============================================================================
-// CONTROL POINT GENERATION AND DISPLAY
+// CONTROL POINT GENERATION, LOADING AND DISPLAY
 // ============================================================================
 
 /**
@@ -39,4 +39,36 @@ Vec3* createSpiralPath(int* outCount);
  */
 void printControlPoints(const Vec3* points, int count);
 
+/**
+ * Loads control points from a text file
+ * 
+ * One point per line as three numbers separated by blanks or commas:
+ *   x y z
+ * Each number must be followed by a blank, a comma, a '#' comment or the
+ * end of the line. Blank lines and '#' comments are ignored. The file is memory-mapped and
+ * parsed with a hand-written number scanner (no sscanf), so very large
+ * files load at close to disk bandwidth.
+ * 
+ * Parse errors are reported as "file:line: message" on stderr.
+ * 
+ * @param filename Path to text file
+ * @param outCount Output: number of control points loaded (0 on error)
+ * @return Dynamically allocated array of Vec3 control points (caller must free with free()), or NULL on error
+ */
+Vec3* loadControlPoints(const char* filename, int* outCount);
+
+/**
+ * Parses one line of a control point text file
+ * 
+ * Same syntax as loadControlPoints; used by loaders that read line by line
+ * (e.g. streaming from a pipe).
+ * 
+ * @param line Start of the line
+ * @param end End of the line (excluding the newline)
+ * @param outPoint Output: parsed point
+ * @param outError Output: static error message (only set on error)
+ * @return 1 if a point was parsed, 0 for blank or comment lines, -1 on syntax error
+ */
+int parseControlPointLine(const char* line, const char* end, Vec3* outPoint, const char** outError);
+
 #endif // FILE_IO_H
@@ -0,0 +1,43 @@
+#include "frame_clock.h"
+#include <time.h>
+
+double frameclock_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void frameclock_init(FrameClock* clock, double timestep, double maxFrameTime) {
+    clock->timestep = timestep;
+    clock->maxFrameTime = (maxFrameTime > timestep) ? maxFrameTime : timestep;
+    clock->accumulator = 0.0;
+    clock->steps = 0;
+    frameclock_resume(clock);
+}
+
+void frameclock_resume(FrameClock* clock) {
+    clock->lastTime = frameclock_now();
+}
+
+int frameclock_advance(FrameClock* clock) {
+    double now = frameclock_now();
+    double elapsed = now - clock->lastTime;
+    clock->lastTime = now;
+
+    // A stalled frame (window drag, debugger) must not trigger a burst of steps
+    if (elapsed > clock->maxFrameTime) elapsed = clock->maxFrameTime;
+    if (elapsed < 0.0) elapsed = 0.0;
+
+    clock->accumulator += elapsed;
+    int steps = (int)(clock->accumulator / clock->timestep);
+    clock->accumulator -= steps * clock->timestep;
+    if (clock->accumulator < 0.0) clock->accumulator = 0.0;  // Rounding
+
+    clock->steps += (unsigned long)steps;
+    return steps;
+}
+
+double frameclock_alpha(const FrameClock* clock) {
+    double alpha = clock->accumulator / clock->timestep;
+    return (alpha < 1.0) ? alpha : 1.0;
+}
@@ -0,0 +1,64 @@
+#ifndef FRAME_CLOCK_H
+#define FRAME_CLOCK_H
+
+// ============================================================================
+// FIXED-TIMESTEP ANIMATION CLOCK
+// Real time is collected in an accumulator and spent in whole simulation
+// steps, so animation speed does not depend on the frame rate. The time
+// left over (less than one step) gives the interpolation factor between the
+// previous and current simulation state for rendering.
+// ============================================================================
+
+typedef struct {
+    double timestep;       // Seconds per simulation step
+    double maxFrameTime;   // Longer gaps are cut to this (no catch-up after stalls)
+    double accumulator;    // Real time not yet simulated, in [0, timestep)
+    double lastTime;       // frameclock_now() at the last advance or resume
+    unsigned long steps;   // Steps taken since frameclock_init
+} FrameClock;
+
+/**
+ * Monotonic time
+ *
+ * @return Seconds since an arbitrary fixed point
+ */
+double frameclock_now(void);
+
+/**
+ * Initialize clock (starts now, nothing accumulated)
+ *
+ * @param clock Clock to initialize
+ * @param timestep Seconds per simulation step (> 0)
+ * @param maxFrameTime Most real time one advance may simulate (>= timestep)
+ */
+void frameclock_init(FrameClock* clock, double timestep, double maxFrameTime);
+
+/**
+ * Restart timing from now (e.g. after a pause, so the pause is not simulated)
+ *
+ * The accumulated fraction of a step is kept, so interpolation continues
+ * from where it stopped.
+ *
+ * @param clock Clock
+ */
+void frameclock_resume(FrameClock* clock);
+
+/**
+ * Add the real time since the last call and take the whole steps it covers
+ *
+ * The caller runs its simulation step once per returned step.
+ *
+ * @param clock Clock
+ * @return Number of simulation steps due (0 if less than one step passed)
+ */
+int frameclock_advance(FrameClock* clock);
+
+/**
+ * Interpolation factor between the previous and current simulation state
+ *
+ * @param clock Clock
+ * @return accumulator / timestep in [0, 1]
+ */
+double frameclock_alpha(const FrameClock* clock);
+
+#endif // FRAME_CLOCK_H
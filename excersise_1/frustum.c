@@ -0,0 +1,57 @@
+#include "frustum.h"
+#include <math.h>
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+Frustum frustum_fromMatrices(const double* projection, const double* modelview) {
+    // clip = projection * modelview, column-major: element (row r, col c) at [c * 4 + r]
+    double clip[16];
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            double sum = 0.0;
+            for (int k = 0; k < 4; k++) {
+                sum += projection[k * 4 + r] * modelview[c * 4 + k];
+            }
+            clip[c * 4 + r] = sum;
+        }
+    }
+
+    // Plane = row 3 +/- row i of the clip matrix
+    Frustum frustum;
+    for (int i = 0; i < 3; i++) {
+        for (int c = 0; c < 4; c++) {
+            frustum.planes[2 * i][c] = clip[c * 4 + 3] + clip[c * 4 + i];
+            frustum.planes[2 * i + 1][c] = clip[c * 4 + 3] - clip[c * 4 + i];
+        }
+    }
+
+    // Normalize so plane distances are in world units
+    for (int i = 0; i < 6; i++) {
+        double* p = frustum.planes[i];
+        double len = sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (len > 1e-12) {
+            p[0] /= len;
+            p[1] /= len;
+            p[2] /= len;
+            p[3] /= len;
+        }
+    }
+
+    return frustum;
+}
+
+int frustum_intersectsBox(const Frustum* frustum, const AABB* box) {
+    for (int i = 0; i < 6; i++) {
+        const double* p = frustum->planes[i];
+
+        // Box corner farthest along the plane normal
+        double x = (p[0] >= 0.0) ? box->max.x : box->min.x;
+        double y = (p[1] >= 0.0) ? box->max.y : box->min.y;
+        double z = (p[2] >= 0.0) ? box->max.z : box->min.z;
+
+        if (p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0) return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,43 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include "bspline_bounds.h"
+
+// ============================================================================
+// VIEW-FRUSTUM CULLING
+// Six clip planes extracted from projection * modelview (Gribb-Hartmann).
+// Pure math - the caller reads the matrices from OpenGL.
+// ============================================================================
+
+/**
+ * View frustum in world (modelview input) coordinates
+ *
+ * Point p is inside plane i when
+ *   planes[i][0] p.x + planes[i][1] p.y + planes[i][2] p.z + planes[i][3] >= 0
+ * Order: left, right, bottom, top, near, far.
+ */
+typedef struct {
+    double planes[6][4];
+} Frustum;
+
+/**
+ * Extract frustum planes
+ *
+ * @param projection Column-major 4x4 projection matrix (GL_PROJECTION_MATRIX)
+ * @param modelview Column-major 4x4 modelview matrix (GL_MODELVIEW_MATRIX)
+ * @return Frustum of the combined transform
+ */
+Frustum frustum_fromMatrices(const double* projection, const double* modelview);
+
+/**
+ * Conservative box test
+ *
+ * May report boxes near frustum corners as visible, never the opposite.
+ *
+ * @param frustum View frustum
+ * @param box Axis-aligned box
+ * @return 0 if the box is certainly outside, 1 otherwise
+ */
+int frustum_intersectsBox(const Frustum* frustum, const AABB* box);
+
+#endif // FRUSTUM_H
@@ -26,8 +26,23 @@
 #endif
 
 #include "bspline.h"
+#include "bspline_batch.h"
+#include "bspline_curve.h"
+#include "bspline_editable.h"
+#include "bspline_bvh.h"
+#include "bspline_arclength.h"
+#include "bspline_rmf.h"
+#include "quaternion.h"
+#include "bspline_gl.h"
 #include "obj_loader.h"
+#include "obj_mesh.h"
+#include "obj_instancing.h"
 #include "file_io.h"
+#include "path_file.h"
+#include "track_file.h"
+#include "frame_clock.h"
+#include "agents.h"
+#include "thread_pool.h"
 #include "visualization.h"
 
 // ============================================================================
@@ -36,25 +51,92 @@
 
 // 3D Model Data (Assignment Section 1.5: Must preserve original coordinates!)
 OBJModel* model = NULL;  // Loaded from .obj file (frog, cube, or tetrahedron)
+OBJMesh* modelMesh = NULL;  // GPU copy of model, drawn with one call per object
 
 // B-Spline Curve Data (Assignment Task 2)
+const char* controlFile = NULL;  // Control point file from the command line (NULL = spiral)
 Vec3* controlPoints = NULL;  // Control points defining the path
 int numControlPoints = 0;     // Total number of control points (12 for spiral)
 int numSegments = 0;          // Number of curve segments (points - 3)
+BSplineCurve* curve = NULL;   // Per-segment polynomial form of controlPoints (owned by editableCurve)
+EditableCurve* editableCurve = NULL;  // Owns controlPoints and curve; tracks edited segments
+int selectedPoint = 0;               // Control point moved by I/K
+
+// Curve Picking (left click moves the object to the clicked point of the curve)
+#define PICK_RADIUS_PIXELS 4      // Depth is read this far around the cursor (the curve is thin)
+#define PICK_MAX_DISTANCE 0.25    // World units between the clicked surface and the curve
+SegmentBVH* curveBVH = NULL;      // Closest-point queries; refitted after edits
+int pickPending = 0;              // A click waits for the next display() (needs its depth buffer)
+int pickX = 0, pickY = 0;         // Window coordinates of the click (origin bottom left)
+
+// Curve Tessellation (rebuilt only when the curve or sample count changes)
+BSplineTessellation curveTessellation;
+int curveSamplesPerSegment = 51;  // Samples per segment incl. both ends (t step 0.02)
+
+// Adaptive Tessellation (visible segments rebuilt when the camera moves, edited ones after edits)
+AdaptiveTessellation adaptiveTessellation;
+int adaptiveCurve = 0;            // 0 = uniform samples, 1 = screen-space error bound
+double adaptivePixels = 0.5;      // Max chord deviation on screen
 
 // Animation State (Assignment Task 3)
 int currentSegment = 1;  // Current B-spline segment being traversed [1, numSegments]
 float t = 0.0f;          // Parameter within current segment [0.0, 1.0]
-float tSpeed = 0.01f;    // Animation speed (how fast t increments per frame)
+float tSpeed = 0.01f;    // Animation speed (how much t increments per SPEED_TIME_UNIT)
 int paused = 0;          // Animation paused flag (0 = playing, 1 = paused)
 
+// Animation Clock (fixed simulation step; rendering interpolates between steps)
+#define SPEED_TIME_UNIT (1.0 / 60.0)       // tSpeed is per this many seconds (one frame at 60 Hz)
+#define SIMULATION_TIMESTEP (1.0 / 120.0)  // Seconds per simulation step
+#define MAX_FRAME_TIME 0.25                // Longest real time one frame may simulate
+#define TARGET_FPS 60                      // Redraw rate while the animation runs
+FrameClock animationClock;
+int frameTimerPending = 0;            // A glutTimerFunc callback is queued
+double nextFrameTime = 0.0;           // frameclock_now() when the next frame is due
+double previousPathPosition = 0.0;    // pathPosition() before the last simulation step
+
+// Interpolated state drawn this frame (set by updateRenderState)
+int renderSegment = 1;
+float renderT = 0.0f;
+double renderTrackTime = 0.0;
+ArcLengthCursor renderCursor = {0};   // Separate hint: render lookups lag the simulation
+
+// Constant-Speed Traversal (arc-length reparameterization)
+ArcLengthTable* arcTable = NULL;  // Cumulative arc lengths of curve
+ArcLengthCursor arcCursor = {0};  // Lookup hint (object moves monotonically)
+int constantSpeed = 0;            // 0 = advance t by tSpeed, 1 = advance distance
+double distanceTravelled = 0.0;   // Distance from curve start (constant-speed mode)
+
 // Orientation Mode Selection (Assignment Task 3.5: Compare both methods!)
 typedef enum {
     MODE_AXIS_ANGLE,  // Uses equations 1.5 & 1.6 from Section 1.4
-    MODE_DCM_FRENET   // Uses equations 1.7-1.9 from Section 1.6 (Frenet-Serret frame)
+    MODE_DCM_FRENET,  // Uses equations 1.7-1.9 from Section 1.6 (Frenet-Serret frame)
+    MODE_RMF          // Baked rotation-minimizing frames (no flips on straight parts)
 } OrientationMode;
 
 OrientationMode orientMode = MODE_AXIS_ANGLE;  // Default method
+const char* orientModeNames[] = {"Axis-Angle", "DCM/Frenet", "RMF"};
+
+RMFTable* rmfTable = NULL;  // Rotation-minimizing frames, re-propagated after edits
+#define RMF_SAMPLES_PER_SEGMENT 16  // Quaternion keys per segment (16 bytes each)
+
+// Baked Track Playback (position + rotation from a table, no spline math)
+#define TRACK_SAMPLE_TIME SPEED_TIME_UNIT  // Seconds between baked samples
+Track* track = NULL;            // Rebaked when curve, orientation mode or speed change
+int trackPlayback = 0;          // 0 = evaluate curve every frame, 1 = play baked track
+double trackTime = 0.0;         // Playback position in seconds
+unsigned long trackRevision = 0;
+OrientationMode trackMode = MODE_AXIS_ANGLE;
+float trackSpeed = 0.0f;
+
+// Agent Crowd (many objects on the same path, structure-of-arrays state)
+#define NUM_AGENTS 1000
+#define AGENT_SPEED_SPREAD 0.3f   // Each agent within +-30% of the main object's speed
+#define AGENT_SEED 12345u
+AgentSystem* agents = NULL;       // Created on first use
+ThreadPool* agentPool = NULL;     // Workers for agents_update (NULL runs single-threaded)
+OBJInstancer* agentInstancer = NULL;  // Draws the whole crowd in one call
+int showAgents = 0;
+double agentPendingTime = 0.0;    // Simulated seconds not yet applied to the agents
 
 // Display Toggle Options
 int showCurve = 1;           // Show B-spline curve path
@@ -124,13 +206,23 @@ void init() {
     normalizeModel(model);
     printOBJInfo(model);
     
-    // Load control points (task 2)
-    // Option 1: Load from file (commented out for task 4)
-    // const char* controlFile = "assets/control_points.txt";
-    // controlPoints = loadControlPoints(controlFile, &numControlPoints);
+    // Upload once; frames then draw from GPU buffers
+    modelMesh = createOBJMesh(model);
+    if (!modelMesh) {
+        fprintf(stderr, "Failed to upload OBJ model. Exiting.\n");
+        exit(1);
+    }
     
-    // Option 2: Use spiral path (task 4) - ACTIVE NOW!
-    controlPoints = createSpiralPath(&numControlPoints);
+    // Load control points (task 2)
+    // Option 1: Load from file given on the command line (text or binary path file)
+    // Option 2: Use spiral path (task 4) - default
+    if (controlFile && pathfile_isPathFile(controlFile)) {
+        controlPoints = pathfile_readPoints(controlFile, &numControlPoints);  // Copy - points are editable
+    } else if (controlFile) {
+        controlPoints = loadControlPoints(controlFile, &numControlPoints);
+    } else {
+        controlPoints = createSpiralPath(&numControlPoints);
+    }
     
     if (!controlPoints || numControlPoints < 4) {
         fprintf(stderr, "Error: Need at least 4 control points for B-spline curve\n");
@@ -146,12 +238,56 @@ void init() {
     // Calculate number of segments (section 1.1)
     numSegments = bspline_getNumSegments(numControlPoints);
     printf("\nB-spline segments: %d\n", numSegments);
+    printf("Batch evaluation kernel: %s\n", bspline_batchKernelName());
     
     if (numSegments <= 0) {
         fprintf(stderr, "Error: Not enough control points for curve\n");
         exit(1);
     }
     
+    // Convert segments to power form once - per-frame queries become Horner evaluations.
+    // The editable curve takes over controlPoints and recompiles only edited segments.
+    editableCurve = bspline_createEditable(controlPoints, numControlPoints);
+    if (!editableCurve) {
+        fprintf(stderr, "Error: Failed to compile B-spline curve\n");
+        exit(1);
+    }
+    curve = editableCurve->curve;
+    
+    // Segment hierarchy for mouse picking
+    curveBVH = bspline_buildBVH(controlPoints, numControlPoints, curve);
+    if (!curveBVH) {
+        fprintf(stderr, "Error: Failed to build curve hierarchy\n");
+        exit(1);
+    }
+    
+    // Arc-length table for constant-speed traversal
+    arcTable = bspline_buildArcLengthTable(curve, 8);
+    if (!arcTable) {
+        fprintf(stderr, "Error: Failed to build arc-length table\n");
+        exit(1);
+    }
+    printf("Curve length: %.2f\n", arcTable->totalLength);
+    
+    // Rotation-minimizing frames for MODE_RMF
+    rmfTable = bspline_buildRMFTable(curve, RMF_SAMPLES_PER_SEGMENT);
+    if (!rmfTable) {
+        fprintf(stderr, "Error: Failed to build rotation-minimizing frames\n");
+        exit(1);
+    }
+    
+    // Tessellate once with forward differencing; display just submits the vertices
+    bspline_initTessellation(&curveTessellation, NULL, 0);
+    if (!bspline_buildTessellation(&curveTessellation, curve, curveSamplesPerSegment)) {
+        fprintf(stderr, "Error: Failed to tessellate B-spline curve\n");
+        exit(1);
+    }
+    bspline_initAdaptiveTessellation(&adaptiveTessellation);
+    bspline_attachCaches(editableCurve, &curveTessellation, arcTable, &adaptiveTessellation, rmfTable);
+    
+    // One worker per CPU for the crowd update, created once and reused every frame
+    agentPool = threadpool_create(0);
+    
     // OpenGL initialization
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_LIGHTING);
@@ -189,6 +325,14 @@ void init() {
     printf("  1/3/4 - Screen elements (curve/points/grid)\n");
     printf("  5 - Object axes (X/Y/Z arrows on object)\n");
     printf("  6 - Wireframe toggle\n");
+    printf("  [/] - Curve detail down/up\n");
+    printf("  T - Adaptive curve tessellation toggle\n");
+    printf("  V - Constant speed (arc length) toggle\n");
+    printf("  M - Orientation mode (Axis-Angle / DCM / RMF)\n");
+    printf("  L - Baked track playback toggle\n");
+    printf("  N - Agent crowd toggle (%d objects)\n", NUM_AGENTS);
+    printf("  E - Select next control point, I/K - Move it up/down\n");
+    printf("  Left click - Move object to the clicked point of the curve\n");
     printf("  ESC - Exit\n");
     printf("\n*** Object rotation angles shown in top-left! ***\n");
     printf("*** Tangents display is in object rotation line! ***\n");
@@ -237,8 +381,9 @@ void renderHUD() {
     
     // Speed and status info
     char statusText[128];
-    snprintf(statusText, sizeof(statusText), "Speed: %.3f | Segment: %d/%d | %s", 
-            tSpeed, currentSegment, numSegments, paused ? "PAUSED" : "Playing");
+    snprintf(statusText, sizeof(statusText), "Speed: %.3f%s | Segment: %d/%d | %s | %s", 
+            tSpeed, trackPlayback ? " (track)" : (constantSpeed ? " (const)" : ""),
+            currentSegment, numSegments, orientModeNames[orientMode], paused ? "PAUSED" : "Playing");
     glColor3f(0.7f, 0.7f, 1.0f);  // Light blue
     renderText(10, windowHeight - 60, statusText, GLUT_BITMAP_9_BY_15);
     
@@ -318,6 +463,15 @@ void renderControlMenu() {
     renderText(startX, y, "4 - Grid/Axes", GLUT_BITMAP_8_BY_13); y -= lineHeight;
     renderText(startX, y, "5 - Object Axes", GLUT_BITMAP_8_BY_13); y -= lineHeight;
     renderText(startX, y, "6 - Wireframe", GLUT_BITMAP_8_BY_13); y -= lineHeight;
+    renderText(startX, y, "[/] - Curve detail", GLUT_BITMAP_8_BY_13); y -= lineHeight;
+    renderText(startX, y, "T - Adaptive curve", GLUT_BITMAP_8_BY_13); y -= lineHeight;
+    renderText(startX, y, "V - Constant speed", GLUT_BITMAP_8_BY_13); y -= lineHeight;
+    renderText(startX, y, "M - Orientation mode", GLUT_BITMAP_8_BY_13); y -= lineHeight;
+    renderText(startX, y, "L - Baked track", GLUT_BITMAP_8_BY_13); y -= lineHeight;
+    renderText(startX, y, "N - Agent crowd", GLUT_BITMAP_8_BY_13); y -= lineHeight;
+    renderText(startX, y, "E - Select point", GLUT_BITMAP_8_BY_13); y -= lineHeight;
+    renderText(startX, y, "I/K - Move point", GLUT_BITMAP_8_BY_13); y -= lineHeight;
+    renderText(startX, y, "Click - Jump on curve", GLUT_BITMAP_8_BY_13); y -= lineHeight;
     renderText(startX, y, "ESC - Exit", GLUT_BITMAP_8_BY_13);
     
     glMatrixMode(GL_PROJECTION);
@@ -329,24 +483,287 @@ void renderControlMenu() {
     glEnable(GL_LIGHTING);
 }
 
+// ============================================================================
+// ANIMATION
+// ============================================================================
+
+/**
+ * Position along the path in the units of the active traversal
+ *
+ * Track playback: seconds; constant speed: distance; otherwise
+ * (segment - 1) + t. Wraps to 0 after pathPeriod().
+ */
+double pathPosition() {
+    if (trackPlayback) return trackTime;
+    if (constantSpeed) return distanceTravelled;
+    return (currentSegment - 1) + t;
+}
+
+double pathPeriod() {
+    if (trackPlayback) return track ? track->duration : 0.0;
+    if (constantSpeed) return arcTable->totalLength;
+    return numSegments;
+}
+
+/**
+ * Draw the current state until the next step (after jumps: reset, mode switch, edit)
+ */
+void resetInterpolation() {
+    previousPathPosition = pathPosition();
+}
+
+/**
+ * Advance the animation by one SIMULATION_TIMESTEP
+ */
+void stepAnimation() {
+    previousPathPosition = pathPosition();
+    if (showAgents) agentPendingTime += SIMULATION_TIMESTEP;
+    float advance = tSpeed * (float)(SIMULATION_TIMESTEP / SPEED_TIME_UNIT);
+    
+    if (trackPlayback) {
+        trackTime += SIMULATION_TIMESTEP;
+        if (track && trackTime >= track->duration) {
+            trackTime -= track->duration;
+        }
+        return;
+    }
+    
+    // Section 1.5: Only parameter changes, NOT object coordinates!
+    if (constantSpeed) {
+        // Same world distance every step: tSpeed scaled by mean segment length
+        distanceTravelled += advance * (arcTable->totalLength / numSegments);
+        if (distanceTravelled >= arcTable->totalLength) {
+            distanceTravelled -= arcTable->totalLength;
+        }
+        bspline_arcLengthToParameterHinted(arcTable, distanceTravelled, &arcCursor,
+                                           &currentSegment, &t);
+        return;
+    }
+    
+    t += advance;
+    
+    if (t >= 1.0f) {
+        t -= 1.0f;
+        currentSegment++;
+        
+        // Loop back to start
+        if (currentSegment > numSegments) {
+            currentSegment = 1;
+        }
+    }
+}
+
+/**
+ * Interpolate between the last two simulation steps for drawing
+ *
+ * Sets renderSegment / renderT / renderTrackTime. Drawing lags the
+ * simulation by less than one step, in exchange for smooth motion at
+ * any frame rate.
+ */
+void updateRenderState() {
+    double period = pathPeriod();
+    double current = pathPosition();
+    double previous = previousPathPosition;
+    if (current < previous) previous -= period;  // Wrapped during the last step
+    
+    double position = previous + (current - previous) * frameclock_alpha(&animationClock);
+    if (position < 0.0) position += period;
+    
+    if (trackPlayback) {
+        renderTrackTime = position;  // track_sample wraps
+    } else if (constantSpeed) {
+        bspline_arcLengthToParameterHinted(arcTable, position, &renderCursor,
+                                           &renderSegment, &renderT);
+    } else {
+        renderSegment = (int)position + 1;
+        if (renderSegment > numSegments) renderSegment = numSegments;
+        renderT = (float)(position - (renderSegment - 1));
+    }
+}
+
+/**
+ * Frame loop: run the simulation steps that are due, redraw, queue the next frame
+ *
+ * Not re-queued while paused, so GLUT blocks waiting for input and the
+ * process uses no CPU; startFrameLoop() restarts it.
+ */
+void frameTimer(int value) {
+    frameTimerPending = 0;
+    if (paused) return;
+    
+    int steps = frameclock_advance(&animationClock);
+    for (int i = 0; i < steps; i++) {
+        stepAnimation();
+    }
+    glutPostRedisplay();
+    
+    // Schedule against the deadline, not the callback time, to hold TARGET_FPS
+    double now = frameclock_now();
+    nextFrameTime += 1.0 / TARGET_FPS;
+    if (nextFrameTime < now) nextFrameTime = now;  // Fell behind - don't catch up
+    glutTimerFunc((unsigned int)((nextFrameTime - now) * 1000.0 + 0.5), frameTimer, 0);
+    frameTimerPending = 1;
+}
+
+void startFrameLoop() {
+    if (paused || frameTimerPending) return;
+    
+    frameclock_resume(&animationClock);  // Time spent paused is not simulated
+    nextFrameTime = frameclock_now();
+    glutTimerFunc(0, frameTimer, 0);
+    frameTimerPending = 1;
+}
+
+// ============================================================================
+// PICKING
+// ============================================================================
+
+/**
+ * Jump the object to a point of the curve in every traversal mode
+ */
+void moveObjectTo(const CurveHit* hit) {
+    currentSegment = hit->segment;
+    t = hit->t;
+    distanceTravelled = bspline_parameterToArcLength(arcTable, hit->segment, hit->t);
+    if (track) trackTime = distanceTravelled / track->speed;
+    resetInterpolation();
+}
+
+/**
+ * Resolve a pending click against the depth buffer of the scene drawn so far
+ *
+ * Every covered pixel around the cursor is unprojected to a world point and
+ * snapped onto the curve through the BVH; the closest hit wins if the
+ * clicked surface is the curve itself (or touches it).
+ */
+void pickCurve() {
+    pickPending = 0;
+    
+    GLint viewport[4];
+    GLdouble projection[16], modelview[16];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetDoublev(GL_PROJECTION_MATRIX, projection);
+    glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
+    
+    int x0 = pickX - PICK_RADIUS_PIXELS, y0 = pickY - PICK_RADIUS_PIXELS;
+    int x1 = pickX + PICK_RADIUS_PIXELS, y1 = pickY + PICK_RADIUS_PIXELS;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > viewport[2] - 1) x1 = viewport[2] - 1;
+    if (y1 > viewport[3] - 1) y1 = viewport[3] - 1;
+    if (x0 > x1 || y0 > y1) return;
+    
+    enum { PICK_SIZE = 2 * PICK_RADIUS_PIXELS + 1 };
+    GLfloat depths[PICK_SIZE * PICK_SIZE];
+    Vec3 points[PICK_SIZE * PICK_SIZE];
+    CurveHit hits[PICK_SIZE * PICK_SIZE];
+    int width = x1 - x0 + 1, height = y1 - y0 + 1;
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x0, y0, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, depths);
+    
+    int count = 0;
+    for (int i = 0; i < width * height; i++) {
+        if (depths[i] >= 1.0f) continue;  // Background
+        GLdouble wx, wy, wz;
+        if (gluUnProject(x0 + i % width + 0.5, y0 + i / width + 0.5, depths[i],
+                         modelview, projection, viewport, &wx, &wy, &wz)) {
+            points[count++] = (Vec3){wx, wy, wz};
+        }
+    }
+    
+    int best = 0;
+    if (count > 0) {
+        bspline_closestPointBatch(curveBVH, points, count, hits);
+        for (int i = 1; i < count; i++) {
+            if (hits[i].distance < hits[best].distance) best = i;
+        }
+    }
+    
+    if (count == 0 || hits[best].distance > PICK_MAX_DISTANCE) {
+        snprintf(hudMessage, sizeof(hudMessage), "No curve under the cursor");
+        return;
+    }
+    moveObjectTo(&hits[best]);
+    snprintf(hudMessage, sizeof(hudMessage), "Jumped to segment %d, t = %.2f",
+            hits[best].segment, hits[best].t);
+}
+
 // ============================================================================
 // RENDERING
 // ============================================================================
 
-void renderObject() {
-    // Task 3.1: Determine position and orientation
-    Vec3 pos = bspline_evaluatePosition(controlPoints, currentSegment, t);
-    Vec3 tangent = bspline_evaluateTangent(controlPoints, currentSegment, t);
+/**
+ * Current orientation mode as a TrackFrame (track and agent orientation)
+ */
+TrackFrame orientationFrame() {
+    static const TrackFrame frames[] = {TRACK_FRAME_AXIS, TRACK_FRAME_FRENET, TRACK_FRAME_RMF};
+    return frames[orientMode];
+}
+
+/**
+ * Bake the track for the current curve, orientation mode and speed
+ *
+ * Same world speed as constant-speed mode: tSpeed mean segment lengths
+ * per SPEED_TIME_UNIT. Cached until one of the three changes.
+ *
+ * @return 1 if a track is available
+ */
+int updateTrack() {
+    if (track && trackRevision == editableCurve->revision &&
+        trackMode == orientMode && trackSpeed == tSpeed) {
+        return 1;
+    }
+    
+    double speed = tSpeed * (arcTable->totalLength / numSegments) / SPEED_TIME_UNIT;
+    Track* baked = track_bake(curve, arcTable, rmfTable, orientationFrame(), speed, TRACK_SAMPLE_TIME);
+    if (!baked) return track != NULL;
     
-    // Draw tangent at current position (task 3.3)
-    if (showTangents) {
-        drawTangentVector(pos, tangent, 1.0f, NULL);  // Yellow tangent
+    // Keep the same place on the path when the speed changes
+    if (track) {
+        double scale = track->speed / speed;
+        trackTime *= scale;
+        if (trackPlayback) previousPathPosition *= scale;
     }
+    track_free(track);
+    track = baked;
+    trackRevision = editableCurve->revision;
+    trackMode = orientMode;
+    trackSpeed = tSpeed;
+    return 1;
+}
+
+void renderObject() {
+    // Task 3.1: Determine position and orientation
+    Vec3 pos;
+    Vec3 tangent = {0.0, 0.0, 1.0};
+    FrenetFrame frame;
+    TrackSample sample;
+    int fromTrack = trackPlayback && updateTrack();
     
-    // Draw Frenet frame if in DCM mode and enabled
-    if (orientMode == MODE_DCM_FRENET && showFrenetFrame) {
-        FrenetFrame frame = bspline_computeFrenetFrame(controlPoints, currentSegment, t);
-        drawFrenetFrame(pos, frame, 1.5f);
+    if (fromTrack) {
+        // Baked track: one lerp + nlerp between two samples, no spline math
+        sample = track_sample(track, renderTrackTime, 1);
+        pos = (Vec3){sample.x, sample.y, sample.z};
+    } else {
+        // One fused evaluation; the Frenet frame is only built in DCM mode
+        FrenetFrame* framePtr = (orientMode == MODE_DCM_FRENET) ? &frame : NULL;
+        CurveJet jet = bspline_curveJet(curve, renderSegment, renderT, framePtr);
+        pos = jet.position;
+        tangent = jet.tangent;
+        
+        if (orientMode == MODE_RMF) {
+            frame = bspline_sampleRMF(rmfTable, renderSegment, renderT);  // O(1) table lookup
+        }
+        
+        // Draw tangent at current position (task 3.3)
+        if (showTangents) {
+            drawTangentVector(pos, tangent, 1.0f, NULL);  // Yellow tangent
+        }
+        
+        // Draw Frenet frame if in DCM mode and enabled
+        if (orientMode != MODE_AXIS_ANGLE && showFrenetFrame) {
+            drawFrenetFrame(pos, frame, 1.5f);
+        }
     }
     
     // Task 3.2 & 3.4: Transform and render object (section 1.5!)
@@ -359,16 +776,18 @@ void renderObject() {
         glTranslatef(pos.x, pos.y, pos.z);
         
         // Task 3.1: Orientation        // Orijentacija (ovisno o modu)
-        if (orientMode == MODE_AXIS_ANGLE) {
+        if (fromTrack) {
+            quat_applyRotation(sample.rotation);  // Baked in the current mode
+        } else if (orientMode == MODE_AXIS_ANGLE) {
             // FORMULE 1.5 & 1.6: Os rotacije i kut rotacije
+            // Same shortest-arc rotation as bspline_computeAxisAngle, in quaternion
+            // form: no acos/degree conversion and no sin/cos inside glRotatef
             Vec3 startOrientation = {0.0, 0.0, 1.0};
-            Vec3 endOrientation = bspline_normalize(tangent);
-            AxisAngle rotation = bspline_computeAxisAngle(startOrientation, endOrientation);
+            Quat rotation = quat_fromTwoVectors(startOrientation, tangent);
             
-            bspline_applyAxisAngle(rotation);
+            quat_applyRotation(rotation);
         } else {
-            // DCM/Frenet metoda (1.6)
-            FrenetFrame frame = bspline_computeFrenetFrame(controlPoints, currentSegment, t);
+            // DCM/Frenet metoda (1.6) - RMF uses the same [w u v] matrix layout
             bspline_applyFrenetFrame(frame);
         }
         
@@ -394,7 +813,7 @@ void renderObject() {
         
         // Task 3.4: Draw object (from ORIGINAL coordinates - section 1.5!)
         glColor3f(0.8f, 0.3f, 0.1f);  // Orange color
-        drawOBJModel(model);
+        drawOBJMesh(modelMesh);
         
         // Draw object axes if enabled
         if (showObjectAxes) {
@@ -434,6 +853,42 @@ void renderObject() {
     glPopMatrix();
 }
 
+/**
+ * Draw every agent of the crowd
+ *
+ * One batched agents_update per drawn frame, split across agentPool,
+ * applies the simulated time since the last frame and rebuilds all model
+ * matrices in the current orientation mode; the matrices go to the GPU as instance data and the
+ * whole crowd is a single draw call.
+ */
+void renderAgents() {
+    if (!agents_update(agents, curve, rmfTable, orientationFrame(), agentPendingTime, agentPool)) return;
+    agentPendingTime = 0.0;
+    
+    if (wireframeMode) {
+        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        glDisable(GL_LIGHTING);
+    } else {
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        glEnable(GL_LIGHTING);
+    }
+    glColor3f(0.2f, 0.5f, 0.8f);  // Blue, to tell the crowd from the main object
+    
+    // Per agent: translation + path orientation, then the object scale of renderObject
+    drawOBJMeshInstanced(agentInstancer, agents->transforms, agents->count, 0.5f);
+    
+    glEnable(GL_LIGHTING);
+}
+
+/**
+ * Agent speeds follow the main object's speed (tSpeed per SPEED_TIME_UNIT)
+ */
+void updateAgentSpeeds() {
+    if (agents) {
+        agents_setSpeeds(agents, tSpeed / (float)SPEED_TIME_UNIT, AGENT_SPEED_SPREAD, AGENT_SEED);
+    }
+}
+
 void display() {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
@@ -463,7 +918,19 @@ void display() {
     // Task 3.3: Draw B-spline curve
     if (showCurve) {
         glDisable(GL_LIGHTING);
-        drawBSplineCurve(controlPoints, numSegments, NULL);
+        if (adaptiveCurve) {
+            // Error bound in pixels; off-screen segments are skipped, unchanged ones reused
+            GLdouble projection[16], modelview[16];
+            glGetDoublev(GL_PROJECTION_MATRIX, projection);
+            glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
+            TessellationTolerance tol = bspline_screenTolerance(adaptivePixels, projection, modelview,
+                                                                windowWidth, windowHeight);
+            CurveEvaluator evaluator = curve_fromCompiled(curve);
+            bspline_updateAdaptiveTessellation(&adaptiveTessellation, &evaluator, editableCurve->bounds, &tol);
+            drawAdaptiveTessellation(&adaptiveTessellation, editableCurve->bounds, NULL);
+        } else {
+            drawCurveTessellation(&curveTessellation, editableCurve->bounds, NULL);  // Frustum-culled
+        }
         glEnable(GL_LIGHTING);
     }
     
@@ -472,11 +939,21 @@ void display() {
         glDisable(GL_LIGHTING);
         drawControlPoints(controlPoints, numControlPoints, 8.0f, NULL);
         drawControlPolygon(controlPoints, numControlPoints, NULL);
+        
+        // Highlight the point moved by I/K
+        const float selectedColor[] = {1.0f, 0.2f, 1.0f};
+        drawControlPoints(&controlPoints[selectedPoint], 1, 14.0f, selectedColor);
         glEnable(GL_LIGHTING);
     }
     
-    // Render animated object
+    // Picking reads the depth of the curve, grid and control points only
+    if (pickPending) pickCurve();
+    
+    // Render animated object (between the last two simulation steps)
+    if (trackPlayback) updateTrack();  // A rebake rescales the path position
+    updateRenderState();
     renderObject();
+    if (showAgents) renderAgents();
     
     // Render HUD (top left - status messages)
     renderHUD();
@@ -500,29 +977,6 @@ void reshape(int w, int h) {
     glMatrixMode(GL_MODELVIEW);
 }
 
-// ============================================================================
-// ANIMATION
-// ============================================================================
-
-void idle() {
-    if (paused) return;
-    
-    // Section 1.5: Only parameter changes, NOT object coordinates!
-    t += tSpeed;
-    
-    if (t >= 1.0f) {
-        t -= 1.0f;
-        currentSegment++;
-        
-        // Loop back to start
-        if (currentSegment > numSegments) {
-            currentSegment = 1;
-        }
-    }
-    
-    glutPostRedisplay();
-}
-
 // ============================================================================
 // INPUT HANDLING
 // ============================================================================
@@ -532,12 +986,14 @@ void keyboard(unsigned char key, int x, int y) {
         case 'p':  // Pause/resume animation
         case 'P':
             paused = !paused;
+            startFrameLoop();
             printf("Animation %s\n", paused ? "paused" : "resumed");
             break;
             
         case '+':  // Speed up
         case '=':
             tSpeed += 0.002f;
+            updateAgentSpeeds();
             printf("Speed: %.3f\n", tSpeed);
             break;
             
@@ -545,6 +1001,7 @@ void keyboard(unsigned char key, int x, int y) {
         case '_':
             tSpeed -= 0.002f;
             if (tSpeed < 0.001f) tSpeed = 0.001f;
+            updateAgentSpeeds();
             printf("Speed: %.3f\n", tSpeed);
             break;
             
@@ -579,6 +1036,109 @@ void keyboard(unsigned char key, int x, int y) {
             printf("Rendering mode: %s\n", wireframeMode ? "WIREFRAME" : "SOLID");
             break;
             
+        case '[':  // Fewer curve samples
+        case ']':  // More curve samples
+            if (key == '[' && curveSamplesPerSegment > 3) {
+                curveSamplesPerSegment = (curveSamplesPerSegment - 1) / 2 + 1;
+            } else if (key == ']' && curveSamplesPerSegment < 4097) {
+                curveSamplesPerSegment = (curveSamplesPerSegment - 1) * 2 + 1;
+            }
+            bspline_buildTessellation(&curveTessellation, curve, curveSamplesPerSegment);
+            printf("Curve samples per segment: %d (%d vertices)\n",
+                   curveSamplesPerSegment, curveTessellation.numVertices);
+            break;
+            
+        case 't':  // Toggle adaptive tessellation
+        case 'T':
+            adaptiveCurve = !adaptiveCurve;
+            printf("Adaptive tessellation: %s\n", adaptiveCurve ? "ON" : "OFF");
+            break;
+            
+        case 'v':  // Toggle constant-speed traversal
+        case 'V':
+            constantSpeed = !constantSpeed;
+            if (constantSpeed) {
+                // Continue from the current point on the curve
+                distanceTravelled = bspline_parameterToArcLength(arcTable, currentSegment, t);
+            }
+            resetInterpolation();
+            printf("Constant speed: %s\n", constantSpeed ? "ON" : "OFF");
+            break;
+            
+        case 'l':  // Toggle baked track playback
+        case 'L':
+            if (!trackPlayback && updateTrack()) {
+                // Continue from the current point on the curve
+                trackTime = bspline_parameterToArcLength(arcTable, currentSegment, t) / track->speed;
+                trackPlayback = 1;
+            } else if (trackPlayback) {
+                // Hand the track position back to the curve traversal
+                distanceTravelled = trackTime * track->speed;
+                if (distanceTravelled > arcTable->totalLength) distanceTravelled = arcTable->totalLength;
+                bspline_arcLengthToParameter(arcTable, distanceTravelled, &currentSegment, &t);
+                trackPlayback = 0;
+            }
+            resetInterpolation();
+            printf("Baked track playback: %s", trackPlayback ? "ON" : "OFF");
+            if (trackPlayback) printf(" (%d samples, %.1f s)", track->numSamples, track->duration);
+            printf("\n");
+            break;
+            
+        case 'n':  // Toggle agent crowd
+        case 'N':
+            if (!agents) {
+                agents = agents_create(NUM_AGENTS, numSegments);
+                updateAgentSpeeds();
+            }
+            if (!agentInstancer) {
+                agentInstancer = createOBJInstancer(modelMesh);
+            }
+            showAgents = agents && agentInstancer && !showAgents;
+            agentPendingTime = 0.0;
+            printf("Agent crowd: %s (%d agents, %s)\n", showAgents ? "ON" : "OFF", NUM_AGENTS,
+                   isOBJInstancingSupported(agentInstancer) ? "instanced" : "one draw per agent");
+            break;
+            
+        case 'm':  // Cycle orientation mode
+        case 'M':
+            orientMode = (OrientationMode)((orientMode + 1) % 3);
+            printf("Orientation mode: %s\n", orientModeNames[orientMode]);
+            break;
+            
+        case 'e':  // Select next control point for editing
+        case 'E':
+            selectedPoint = (selectedPoint + 1) % numControlPoints;
+            snprintf(hudMessage, sizeof(hudMessage), "Control point %d selected | I/K to move",
+                    selectedPoint + 1);
+            break;
+            
+        case 'i':  // Move selected control point up
+        case 'I':
+        case 'k':  // Move selected control point down
+        case 'K': {
+            Vec3 p = controlPoints[selectedPoint];
+            p.z += (key == 'i' || key == 'I') ? 1.0 : -1.0;
+            
+            // Recompiles at most 4 segments; caches follow for those segments only
+            // (rotation-minimizing frames from the first of them to the curve end)
+            int changed = bspline_moveControlPoint(editableCurve, selectedPoint, p);
+            bspline_updateEditable(editableCurve);
+            int firstChanged, lastChanged;
+            if (bspline_affectedSegments(selectedPoint, editableCurve->numSegments, &firstChanged, &lastChanged)) {
+                // Same segments, new boxes for the changed leaves and their ancestors
+                bspline_refitBVHSegments(curveBVH, controlPoints, firstChanged, lastChanged);
+            }
+            
+            if (constantSpeed) {
+                distanceTravelled = bspline_parameterToArcLength(arcTable, currentSegment, t);
+            }
+            resetInterpolation();
+            
+            snprintf(hudMessage, sizeof(hudMessage), "Control point %d: z = %.1f (%d segments updated)",
+                    selectedPoint + 1, p.z, changed);
+            break;
+        }
+            
         case 'g':  // Toggle grid
         case 'G':
             showGrid = !showGrid;
@@ -594,8 +1154,17 @@ void keyboard(unsigned char key, int x, int y) {
             // Reset animation
             currentSegment = 1;
             t = 0.0f;
+            distanceTravelled = 0.0;
+            arcCursor.index = 0;
+            trackTime = 0.0;
             paused = 0;
             tSpeed = 0.01f;  // Reset speed to default
+            resetInterpolation();
+            if (agents) {
+                updateAgentSpeeds();
+                agents_reset(agents);
+            }
+            startFrameLoop();
             // Reset camera
             cameraDistance = 30.0f;
             cameraAngleX = 20.0f;
@@ -686,7 +1255,17 @@ void keyboard(unsigned char key, int x, int y) {
         case 27:  // ESC - exit
             printf("Exiting...\n");
             if (model) freeOBJModel(model);
-            if (controlPoints) free(controlPoints);
+            bspline_freeTessellation(&curveTessellation);
+            bspline_freeAdaptiveTessellation(&adaptiveTessellation);
+            if (rmfTable) bspline_freeRMFTable(rmfTable);
+            track_free(track);
+            agents_free(agents);
+            threadpool_free(agentPool);
+            freeOBJInstancer(agentInstancer);
+            freeOBJMesh(modelMesh);
+            if (arcTable) bspline_freeArcLengthTable(arcTable);
+            bspline_freeBVH(curveBVH);
+            if (editableCurve) bspline_freeEditable(editableCurve);  // Frees curve and controlPoints
             exit(0);
             break;
     }
@@ -694,6 +1273,16 @@ void keyboard(unsigned char key, int x, int y) {
     glutPostRedisplay();
 }
 
+void mouse(int button, int state, int x, int y) {
+    if (button != GLUT_LEFT_BUTTON || state != GLUT_DOWN) return;
+    
+    // Resolved in display(), where the depth buffer holds the current scene
+    pickPending = 1;
+    pickX = x;
+    pickY = windowHeight - 1 - y;
+    glutPostRedisplay();
+}
+
 void specialKeys(int key, int x, int y) {
     // Only respond to UP and DOWN arrows
     if (key != GLUT_KEY_UP && key != GLUT_KEY_DOWN) {
@@ -754,15 +1343,24 @@ int main(int argc, char** argv) {
     glutInitWindowPosition(100, 100);
     glutCreateWindow("Exercise 1: B-Spline Path Following");
     
+    // Optional control point file (glutInit has removed its own arguments)
+    if (argc > 1) {
+        controlFile = argv[1];
+    }
+    
     // Initialize application
     init();
     
     // Register callbacks
     glutDisplayFunc(display);
     glutReshapeFunc(reshape);
-    glutIdleFunc(idle);
     glutKeyboardFunc(keyboard);
     glutSpecialFunc(specialKeys);
+    glutMouseFunc(mouse);
+    
+    // Fixed-step animation driven by a timer (no idle callback)
+    frameclock_init(&animationClock, SIMULATION_TIMESTEP, MAX_FRAME_TIME);
+    startFrameLoop();
     
     // Start main loop
     printf("Starting animation...\n\n");
@@ -0,0 +1,287 @@
+#include "nurbs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Homogeneous control point (x w, y w, z w, w)
+typedef struct {
+    double x, y, z, w;
+} Vec4;
+
+// ============================================================================
+// CREATION
+// ============================================================================
+
+NurbsCurve* nurbs_create(const Vec3* controlPoints, const double* weights, int numControlPoints,
+                         const double* knots, int degree) {
+    if (!controlPoints || !knots || degree < 1 || degree > NURBS_MAX_DEGREE ||
+        numControlPoints <= degree) {
+        fprintf(stderr, "Error: Invalid NURBS definition (degree %d, %d control points)\n",
+                degree, numControlPoints);
+        return NULL;
+    }
+
+    int numKnots = numControlPoints + degree + 1;
+    for (int i = 1; i < numKnots; i++) {
+        if (knots[i] < knots[i - 1]) {
+            fprintf(stderr, "Error: NURBS knot vector is decreasing at index %d\n", i);
+            return NULL;
+        }
+    }
+    if (weights) {
+        for (int i = 0; i < numControlPoints; i++) {
+            if (weights[i] <= 0.0) {
+                fprintf(stderr, "Error: NURBS weight %d is not positive\n", i);
+                return NULL;
+            }
+        }
+    }
+
+    NurbsCurve* curve = (NurbsCurve*)calloc(1, sizeof(NurbsCurve));
+    if (!curve) return NULL;
+
+    curve->numControlPoints = numControlPoints;
+    curve->numKnots = numKnots;
+    curve->degree = degree;
+    curve->controlPoints = (Vec3*)malloc(numControlPoints * sizeof(Vec3));
+    curve->knots = (double*)malloc(numKnots * sizeof(double));
+    curve->segmentSpans = (int*)malloc((numControlPoints - degree) * sizeof(int));
+    if (weights) {
+        curve->weights = (double*)malloc(numControlPoints * sizeof(double));
+    }
+
+    if (!curve->controlPoints || !curve->knots || !curve->segmentSpans ||
+        (weights && !curve->weights)) {
+        nurbs_free(curve);
+        return NULL;
+    }
+
+    memcpy(curve->controlPoints, controlPoints, numControlPoints * sizeof(Vec3));
+    memcpy(curve->knots, knots, numKnots * sizeof(double));
+    if (weights) {
+        memcpy(curve->weights, weights, numControlPoints * sizeof(double));
+    }
+
+    // Segments = non-empty spans inside the domain [u_p, u_n]
+    curve->numSegments = 0;
+    for (int k = degree; k < numControlPoints; k++) {
+        if (knots[k + 1] > knots[k]) {
+            curve->segmentSpans[curve->numSegments++] = k;
+        }
+    }
+    if (curve->numSegments == 0) {
+        fprintf(stderr, "Error: NURBS knot vector has an empty domain\n");
+        nurbs_free(curve);
+        return NULL;
+    }
+
+    return curve;
+}
+
+NurbsCurve* nurbs_createUniformCubic(const Vec3* controlPoints, int numControlPoints) {
+    if (!controlPoints || numControlPoints < 4) {
+        fprintf(stderr, "Error: Need at least 4 control points for cubic B-spline\n");
+        return NULL;
+    }
+
+    int numKnots = numControlPoints + 4;
+    double* knots = (double*)malloc(numKnots * sizeof(double));
+    if (!knots) return NULL;
+
+    for (int i = 0; i < numKnots; i++) {
+        knots[i] = (double)i;
+    }
+
+    NurbsCurve* curve = nurbs_create(controlPoints, NULL, numControlPoints, knots, 3);
+    free(knots);
+    return curve;
+}
+
+void nurbs_free(NurbsCurve* curve) {
+    if (curve) {
+        if (curve->controlPoints) free(curve->controlPoints);
+        if (curve->weights) free(curve->weights);
+        if (curve->knots) free(curve->knots);
+        if (curve->segmentSpans) free(curve->segmentSpans);
+        free(curve);
+    }
+}
+
+void nurbs_getDomain(const NurbsCurve* curve, double* outStart, double* outEnd) {
+    if (outStart) *outStart = curve->knots[curve->degree];
+    if (outEnd) *outEnd = curve->knots[curve->numControlPoints];
+}
+
+// ============================================================================
+// KNOT SPAN SEARCH
+// ============================================================================
+
+static int spanContains(const NurbsCurve* curve, int k, double u) {
+    return k >= curve->degree && k < curve->numControlPoints &&
+           curve->knots[k] <= u && u < curve->knots[k + 1];
+}
+
+int nurbs_findSpan(const NurbsCurve* curve, double u, NurbsCursor* cursor) {
+    const double* U = curve->knots;
+    int p = curve->degree;
+    int n = curve->numControlPoints;
+    int k;
+
+    if (u >= U[n]) {
+        // End of domain belongs to the last non-empty span
+        k = curve->segmentSpans[curve->numSegments - 1];
+    } else if (u <= U[p]) {
+        k = curve->segmentSpans[0];
+    } else if (cursor && spanContains(curve, cursor->span, u)) {
+        k = cursor->span;
+    } else if (cursor && spanContains(curve, cursor->span + 1, u)) {
+        k = cursor->span + 1;
+    } else {
+        // Binary search (The NURBS Book, A2.1)
+        int lo = p;
+        int hi = n;
+        k = (lo + hi) / 2;
+        while (u < U[k] || u >= U[k + 1]) {
+            if (u < U[k]) {
+                hi = k;
+            } else {
+                lo = k;
+            }
+            k = (lo + hi) / 2;
+        }
+    }
+
+    if (cursor) cursor->span = k;
+    return k;
+}
+
+// ============================================================================
+// DE BOOR EVALUATION
+// ============================================================================
+
+/**
+ * de Boor's algorithm on local homogeneous points d[0..p] of span k
+ *
+ * d[j] holds P_{k-p+j}. For r = 1..p and j = p..r:
+ *   alpha = (u - u_i) / (u_{i+p+1-r} - u_i),  i = k - p + j
+ *   d[j]  = (1 - alpha) d[j-1] + alpha d[j]
+ * Result is d[p]. d is overwritten.
+ */
+static Vec4 deBoor(Vec4* d, int p, const double* U, int k, double u) {
+    for (int r = 1; r <= p; r++) {
+        for (int j = p; j >= r; j--) {
+            int i = k - p + j;
+            double denom = U[i + p + 1 - r] - U[i];
+            double alpha = (denom > 0.0) ? (u - U[i]) / denom : 0.0;
+            double beta = 1.0 - alpha;
+            d[j].x = beta * d[j - 1].x + alpha * d[j].x;
+            d[j].y = beta * d[j - 1].y + alpha * d[j].y;
+            d[j].z = beta * d[j - 1].z + alpha * d[j].z;
+            d[j].w = beta * d[j - 1].w + alpha * d[j].w;
+        }
+    }
+    return d[p];
+}
+
+static void loadHomogeneous(const NurbsCurve* curve, int k, Vec4* d) {
+    int p = curve->degree;
+    for (int j = 0; j <= p; j++) {
+        int i = k - p + j;
+        double w = curve->weights ? curve->weights[i] : 1.0;
+        Vec3 P = curve->controlPoints[i];
+        d[j] = (Vec4){P.x * w, P.y * w, P.z * w, w};
+    }
+}
+
+/**
+ * Position and/or derivative with respect to u inside span k
+ *
+ * The derivative of the homogeneous curve is a degree p-1 B-spline with
+ * control points Q_i = p (P_{i+1} - P_i) / (u_{i+p+1} - u_{i+1}) on the
+ * knot vector without its first knot, evaluated again with de Boor.
+ */
+static void evaluateInSpan(const NurbsCurve* curve, int k, double u, Vec3* outPos, Vec3* outDeriv) {
+    int p = curve->degree;
+    const double* U = curve->knots;
+
+    Vec4 d[NURBS_MAX_DEGREE + 1];
+    Vec4 q[NURBS_MAX_DEGREE];
+
+    loadHomogeneous(curve, k, d);
+
+    // Derivative control points (must be taken before de Boor overwrites d)
+    if (outDeriv) {
+        for (int j = 0; j < p; j++) {
+            int i = k - p + j;
+            double denom = U[i + p + 1] - U[i + 1];
+            double s = (denom > 0.0) ? p / denom : 0.0;
+            q[j] = (Vec4){
+                s * (d[j + 1].x - d[j].x),
+                s * (d[j + 1].y - d[j].y),
+                s * (d[j + 1].z - d[j].z),
+                s * (d[j + 1].w - d[j].w)
+            };
+        }
+    }
+
+    Vec4 A = deBoor(d, p, U, k, u);
+    Vec3 C = {A.x / A.w, A.y / A.w, A.z / A.w};
+    if (outPos) *outPos = C;
+
+    if (outDeriv) {
+        // Degree p-1 on knots U[1..], span k-1
+        Vec4 dA = deBoor(q, p - 1, U + 1, k - 1, u);
+
+        // C' = (A' - W' C) / W
+        *outDeriv = (Vec3){
+            (dA.x - dA.w * C.x) / A.w,
+            (dA.y - dA.w * C.y) / A.w,
+            (dA.z - dA.w * C.z) / A.w
+        };
+    }
+}
+
+static double clampToDomain(const NurbsCurve* curve, double u) {
+    double u0 = curve->knots[curve->degree];
+    double u1 = curve->knots[curve->numControlPoints];
+    if (u < u0) return u0;
+    if (u > u1) return u1;
+    return u;
+}
+
+Vec3 nurbs_evaluateAt(const NurbsCurve* curve, double u, NurbsCursor* cursor) {
+    u = clampToDomain(curve, u);
+    Vec3 pos;
+    evaluateInSpan(curve, nurbs_findSpan(curve, u, cursor), u, &pos, NULL);
+    return pos;
+}
+
+Vec3 nurbs_evaluateDerivativeAt(const NurbsCurve* curve, double u, NurbsCursor* cursor) {
+    u = clampToDomain(curve, u);
+    Vec3 deriv;
+    evaluateInSpan(curve, nurbs_findSpan(curve, u, cursor), u, NULL, &deriv);
+    return deriv;
+}
+
+// ============================================================================
+// SEGMENT INTERFACE (same convention as bspline.h)
+// ============================================================================
+
+Vec3 nurbs_evaluatePosition(const NurbsCurve* curve, int segment, float t) {
+    int k = curve->segmentSpans[segment - 1];
+    double u = curve->knots[k] + t * (curve->knots[k + 1] - curve->knots[k]);
+
+    Vec3 pos;
+    evaluateInSpan(curve, k, u, &pos, NULL);
+    return pos;
+}
+
+Vec3 nurbs_evaluateTangent(const NurbsCurve* curve, int segment, float t) {
+    int k = curve->segmentSpans[segment - 1];
+    double spanLength = curve->knots[k + 1] - curve->knots[k];
+    double u = curve->knots[k] + t * spanLength;
+
+    Vec3 deriv;
+    evaluateInSpan(curve, k, u, NULL, &deriv);
+    return (Vec3){deriv.x * spanLength, deriv.y * spanLength, deriv.z * spanLength};
+}
@@ -0,0 +1,143 @@
+#ifndef NURBS_H
+#define NURBS_H
+
+#include "bspline.h"
+
+// ============================================================================
+// GENERAL NON-UNIFORM B-SPLINE / NURBS EVALUATOR
+// Arbitrary degree, arbitrary (clamped or open) knot vector, optional
+// rational weights. Evaluation uses de Boor's algorithm in homogeneous
+// coordinates.
+// ============================================================================
+
+// Largest supported degree (local de Boor arrays live on the stack)
+#define NURBS_MAX_DEGREE 7
+
+/**
+ * NURBS curve
+ *
+ * Segments are the non-empty knot spans, numbered 1..numSegments like the
+ * uniform segments in bspline.h; parameter t in [0, 1] maps linearly onto
+ * the span [u_k, u_{k+1}].
+ */
+typedef struct {
+    Vec3* controlPoints;    // numControlPoints points (owned copy)
+    double* weights;        // numControlPoints weights, NULL for non-rational
+    int numControlPoints;   // n
+    double* knots;          // n + degree + 1 non-decreasing knots (owned copy)
+    int numKnots;           // n + degree + 1
+    int degree;             // p (1 to NURBS_MAX_DEGREE)
+    int* segmentSpans;      // Knot span index k of every non-empty segment
+    int numSegments;        // Number of non-empty spans in [u_p, u_n]
+} NurbsCurve;
+
+/**
+ * Knot-span cursor for parameter-space queries
+ *
+ * Remembers the span of the previous query; monotonically advancing
+ * queries find their span in O(1) without a binary search.
+ */
+typedef struct {
+    int span;  // Last knot span index (0 = not yet used)
+} NurbsCursor;
+
+/**
+ * Create NURBS curve (inputs are copied)
+ *
+ * @param controlPoints Array of control points
+ * @param weights Array of positive weights, or NULL for a non-rational B-spline
+ * @param numControlPoints Number of control points (> degree)
+ * @param knots Knot vector with numControlPoints + degree + 1 non-decreasing values
+ * @param degree Curve degree (1 to NURBS_MAX_DEGREE)
+ * @return Newly allocated curve (free with nurbs_free), or NULL on error
+ */
+NurbsCurve* nurbs_create(const Vec3* controlPoints, const double* weights, int numControlPoints,
+                         const double* knots, int degree);
+
+/**
+ * Create NURBS curve equal to the uniform cubic B-spline of bspline.h
+ *
+ * Uses knots 0, 1, ..., n + 3 and unit weights; segment i and parameter t
+ * give the same point as bspline_evaluatePosition(controlPoints, i, t).
+ *
+ * @param controlPoints Array of control points
+ * @param numControlPoints Number of control points (at least 4)
+ * @return Newly allocated curve, or NULL on error
+ */
+NurbsCurve* nurbs_createUniformCubic(const Vec3* controlPoints, int numControlPoints);
+
+/**
+ * Free NURBS curve
+ *
+ * @param curve Curve to free (NULL is allowed)
+ */
+void nurbs_free(NurbsCurve* curve);
+
+/**
+ * Valid parameter range [u_p, u_n]
+ *
+ * @param curve NURBS curve
+ * @param outStart Output first parameter
+ * @param outEnd Output last parameter
+ */
+void nurbs_getDomain(const NurbsCurve* curve, double* outStart, double* outEnd);
+
+/**
+ * Find knot span k with u_k <= u < u_{k+1}
+ *
+ * Checks the cursor span and its successor first, then binary searches.
+ * The end of the domain belongs to the last non-empty span.
+ *
+ * @param curve NURBS curve
+ * @param u Parameter (clamped to the domain)
+ * @param cursor Lookup hint (may be NULL), updated with the found span
+ * @return Knot span index k
+ */
+int nurbs_findSpan(const NurbsCurve* curve, double u, NurbsCursor* cursor);
+
+/**
+ * Evaluate position at global parameter u
+ *
+ * @param curve NURBS curve
+ * @param u Parameter in the curve domain
+ * @param cursor Knot-span cursor (may be NULL)
+ * @return Position on the curve
+ */
+Vec3 nurbs_evaluateAt(const NurbsCurve* curve, double u, NurbsCursor* cursor);
+
+/**
+ * Evaluate first derivative dC/du at global parameter u
+ *
+ * Rational case uses C' = (A' - W' C) / W.
+ *
+ * @param curve NURBS curve
+ * @param u Parameter in the curve domain
+ * @param cursor Knot-span cursor (may be NULL)
+ * @return Derivative with respect to u
+ */
+Vec3 nurbs_evaluateDerivativeAt(const NurbsCurve* curve, double u, NurbsCursor* cursor);
+
+/**
+ * Evaluate position on segment (same convention as bspline_evaluatePosition)
+ *
+ * @param curve NURBS curve
+ * @param segment Segment index (1 to numSegments)
+ * @param t Parameter in [0, 1]
+ * @return Position on the curve
+ */
+Vec3 nurbs_evaluatePosition(const NurbsCurve* curve, int segment, float t);
+
+/**
+ * Evaluate tangent on segment (derivative with respect to local t)
+ *
+ * dC/dt = dC/du * (u_{k+1} - u_k); for nurbs_createUniformCubic curves
+ * this equals bspline_evaluateTangent.
+ *
+ * @param curve NURBS curve
+ * @param segment Segment index (1 to numSegments)
+ * @param t Parameter in [0, 1]
+ * @return Tangent vector (unnormalized)
+ */
+Vec3 nurbs_evaluateTangent(const NurbsCurve* curve, int segment, float t);
+
+#endif // NURBS_H
@@ -0,0 +1,260 @@
+#include "obj_instancing.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GL_GLEXT_PROTOTYPES
+#ifdef __APPLE__
+    #include <GLUT/glut.h>
+    #include <OpenGL/glext.h>
+#else
+    #include <GL/glut.h>
+    #include <GL/glext.h>
+#endif
+
+// Vertex attribute slots (instanceMatrix takes four: one per column)
+#define ATTRIB_POSITION 0
+#define ATTRIB_NORMAL 1
+#define ATTRIB_MATRIX 2
+
+struct OBJInstancer {
+    const OBJMesh* mesh;       // Shared geometry (vertex and index buffers)
+    int supported;             // 1 = instanced path, 0 = fixed-function fallback
+
+    GLuint program;
+    GLint scaleLocation;
+    GLint lightingLocation;
+
+    GLuint instanceBuffer;     // Per-instance model matrices
+    int instanceCapacity;      // Matrices the buffer can hold
+};
+
+// Fixed-function lighting of the viewer: GL_LIGHT0 ambient + diffuse on
+// gl_Color (GL_COLOR_MATERIAL), plus the light model ambient term
+static const char* vertexShaderSource =
+    "#version 120\n"
+    "attribute vec3 position;\n"
+    "attribute vec3 normal;\n"
+    "attribute mat4 instanceMatrix;\n"
+    "uniform float objectScale;\n"
+    "uniform bool lighting;\n"
+    "varying vec4 color;\n"
+    "void main() {\n"
+    "    vec4 eye = gl_ModelViewMatrix * (instanceMatrix * vec4(position * objectScale, 1.0));\n"
+    "    gl_Position = gl_ProjectionMatrix * eye;\n"
+    "    if (!lighting) {\n"
+    "        color = gl_Color;\n"
+    "        return;\n"
+    "    }\n"
+    "    vec3 n = normalize(gl_NormalMatrix * (mat3(instanceMatrix) * normal));\n"
+    "    vec4 light = gl_LightSource[0].position;\n"
+    "    vec3 l = normalize(light.xyz - eye.xyz * light.w);\n"
+    "    vec4 shade = gl_LightModel.ambient + gl_LightSource[0].ambient +\n"
+    "                 max(dot(n, l), 0.0) * gl_LightSource[0].diffuse;\n"
+    "    color = vec4(gl_Color.rgb * shade.rgb, gl_Color.a);\n"
+    "}\n";
+
+static const char* fragmentShaderSource =
+    "#version 120\n"
+    "varying vec4 color;\n"
+    "void main() {\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+static int hasExtension(const char* name) {
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    size_t length = strlen(name);
+
+    for (const char* p = extensions; p && (p = strstr(p, name)) != NULL; p += length) {
+        int startsWord = (p == extensions || p[-1] == ' ');
+        int endsWord = (p[length] == ' ' || p[length] == '\0');
+        if (startsWord && endsWord) return 1;
+    }
+    return 0;
+}
+
+/**
+ * Shaders (GL 2.0) plus instanced draws and per-instance attributes
+ */
+static int instancingAvailable(void) {
+    const char* version = (const char*)glGetString(GL_VERSION);
+    int major = 0;
+    if (!version || sscanf(version, "%d", &major) != 1 || major < 2) return 0;
+    return hasExtension("GL_ARB_draw_instanced") && hasExtension("GL_ARB_instanced_arrays");
+}
+
+static GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint ok = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        fprintf(stderr, "Error: Instancing shader does not compile:\n%s\n", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+static GLuint createProgram(void) {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
+    if (!vertexShader || !fragmentShader) {
+        if (vertexShader) glDeleteShader(vertexShader);
+        if (fragmentShader) glDeleteShader(fragmentShader);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glBindAttribLocation(program, ATTRIB_POSITION, "position");
+    glBindAttribLocation(program, ATTRIB_NORMAL, "normal");
+    glBindAttribLocation(program, ATTRIB_MATRIX, "instanceMatrix");
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);  // Freed together with the program
+    glDeleteShader(fragmentShader);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), NULL, log);
+        fprintf(stderr, "Error: Instancing shader does not link:\n%s\n", log);
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+/**
+ * Delete GPU objects (the instancer falls back to fixed-function drawing)
+ */
+static void releaseGL(OBJInstancer* instancer) {
+    if (instancer->program) glDeleteProgram(instancer->program);
+    if (instancer->instanceBuffer) glDeleteBuffers(1, &instancer->instanceBuffer);
+    instancer->program = 0;
+    instancer->instanceBuffer = 0;
+    instancer->instanceCapacity = 0;
+    instancer->supported = 0;
+}
+
+OBJInstancer* createOBJInstancer(const OBJMesh* mesh) {
+    if (!mesh) {
+        fprintf(stderr, "Error: No mesh to instance\n");
+        return NULL;
+    }
+
+    OBJInstancer* instancer = (OBJInstancer*)calloc(1, sizeof(OBJInstancer));
+    if (!instancer) return NULL;
+    instancer->mesh = mesh;
+
+    if (!mesh->vertexBuffer || !instancingAvailable()) {
+        printf("Instanced rendering not available, drawing copies one by one\n");
+        return instancer;
+    }
+
+    instancer->program = createProgram();
+    if (!instancer->program) {
+        fprintf(stderr, "Warning: Instanced rendering disabled, drawing copies one by one\n");
+        releaseGL(instancer);
+        return instancer;
+    }
+
+    instancer->scaleLocation = glGetUniformLocation(instancer->program, "objectScale");
+    instancer->lightingLocation = glGetUniformLocation(instancer->program, "lighting");
+    glGenBuffers(1, &instancer->instanceBuffer);
+    instancer->supported = 1;
+    return instancer;
+}
+
+void freeOBJInstancer(OBJInstancer* instancer) {
+    if (instancer) {
+        releaseGL(instancer);
+        free(instancer);
+    }
+}
+
+int isOBJInstancingSupported(const OBJInstancer* instancer) {
+    return instancer && instancer->supported;
+}
+
+// ============================================================================
+// DRAWING
+// ============================================================================
+
+static void drawFallback(const OBJInstancer* instancer, const float* matrices, int count, float scale) {
+    for (int i = 0; i < count; i++) {
+        glPushMatrix();
+            glMultMatrixf(matrices + 16 * (size_t)i);
+            glScalef(scale, scale, scale);
+            drawOBJMesh(instancer->mesh);
+        glPopMatrix();
+    }
+}
+
+void drawOBJMeshInstanced(OBJInstancer* instancer, const float* matrices, int count, float scale) {
+    if (!instancer || !matrices || count <= 0) return;
+
+    if (!instancer->supported) {
+        drawFallback(instancer, matrices, count, scale);
+        return;
+    }
+
+    glUseProgram(instancer->program);
+    glUniform1f(instancer->scaleLocation, scale);
+    glUniform1i(instancer->lightingLocation, glIsEnabled(GL_LIGHTING));
+
+    // Mesh
+    const OBJMesh* mesh = instancer->mesh;
+    GLsizei stride = OBJMESH_VERTEX_FLOATS * sizeof(float);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->vertexBuffer);
+    glEnableVertexAttribArray(ATTRIB_POSITION);
+    glVertexAttribPointer(ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, stride, (const void*)0);
+    glEnableVertexAttribArray(ATTRIB_NORMAL);
+    glVertexAttribPointer(ATTRIB_NORMAL, 3, GL_FLOAT, GL_FALSE, stride,
+                          (const void*)(OBJMESH_NORMAL_OFFSET * sizeof(float)));
+
+    // Instance matrices: grow the buffer when needed, otherwise orphan and refill
+    GLsizeiptr bytes = (GLsizeiptr)count * 16 * sizeof(float);
+    glBindBuffer(GL_ARRAY_BUFFER, instancer->instanceBuffer);
+    if (count > instancer->instanceCapacity) {
+        glBufferData(GL_ARRAY_BUFFER, bytes, matrices, GL_STREAM_DRAW);
+        instancer->instanceCapacity = count;
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)instancer->instanceCapacity * 16 * sizeof(float),
+                     NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, matrices);
+    }
+    for (int column = 0; column < 4; column++) {
+        GLuint slot = ATTRIB_MATRIX + column;
+        glEnableVertexAttribArray(slot);
+        glVertexAttribPointer(slot, 4, GL_FLOAT, GL_FALSE, 16 * sizeof(float),
+                              (const void*)(column * 4 * sizeof(float)));
+        glVertexAttribDivisorARB(slot, 1);
+    }
+
+    // All copies in one call
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->indexBuffer);
+    glDrawElementsInstancedARB(GL_TRIANGLES, mesh->numIndices, mesh->indexType,
+                               (const void*)0, count);
+
+    // Restore fixed-function state for the rest of the frame
+    for (int column = 0; column < 4; column++) {
+        glVertexAttribDivisorARB(ATTRIB_MATRIX + column, 0);
+        glDisableVertexAttribArray(ATTRIB_MATRIX + column);
+    }
+    glDisableVertexAttribArray(ATTRIB_NORMAL);
+    glDisableVertexAttribArray(ATTRIB_POSITION);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+}
@@ -0,0 +1,63 @@
+#ifndef OBJ_INSTANCING_H
+#define OBJ_INSTANCING_H
+
+#include "obj_mesh.h"
+
+// ============================================================================
+// INSTANCED OBJ RENDERING
+// Draws many copies of one OBJMesh with a single glDrawElementsInstanced
+// call: the mesh buffers are shared, and per-instance model matrices are
+// streamed to an instance buffer every frame. A small GLSL 1.20 shader
+// reproduces the fixed-function lighting the rest of the viewer uses
+// (GL_LIGHT0 ambient + diffuse, GL_COLOR_MATERIAL).
+//
+// Without shaders, buffer objects or instancing (GL_ARB_draw_instanced and
+// GL_ARB_instanced_arrays) every copy is drawn with drawOBJMesh under its
+// own matrix instead.
+// ============================================================================
+
+typedef struct OBJInstancer OBJInstancer;
+
+/**
+ * Prepare mesh for instanced drawing
+ *
+ * Needs a current OpenGL context. The mesh is shared, not copied, and must
+ * outlive the instancer.
+ *
+ * @param mesh Mesh to draw
+ * @return Newly allocated instancer (free with freeOBJInstancer), or NULL on error
+ */
+OBJInstancer* createOBJInstancer(const OBJMesh* mesh);
+
+/**
+ * Free instancer and its instance buffer (the mesh is not freed)
+ *
+ * @param instancer Instancer to free (NULL is allowed)
+ */
+void freeOBJInstancer(OBJInstancer* instancer);
+
+/**
+ * Check whether draws use instancing or the fixed-function fallback
+ *
+ * @param instancer Instancer
+ * @return 1 if one draw call renders all instances, 0 for the fallback
+ */
+int isOBJInstancingSupported(const OBJInstancer* instancer);
+
+/**
+ * Draw count copies of the mesh
+ *
+ * Copy i is drawn with the current GL_MODELVIEW matrix times matrices[i]
+ * times a uniform scale, i.e. what
+ *   glPushMatrix(); glMultMatrixf(matrices + 16 * i); glScalef(scale, scale, scale);
+ *   drawOBJMesh(mesh); glPopMatrix();
+ * would draw. Uses the current color, polygon mode and GL_LIGHTING state.
+ *
+ * @param instancer Instancer
+ * @param matrices count column-major 4x4 matrices (16 floats each)
+ * @param count Number of copies
+ * @param scale Uniform object scale applied before each matrix
+ */
+void drawOBJMeshInstanced(OBJInstancer* instancer, const float* matrices, int count, float scale);
+
+#endif // OBJ_INSTANCING_H
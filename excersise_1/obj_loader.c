@@ -1,4 +1,5 @@
 #include "obj_loader.h"
+#include "vec3_batch.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -38,6 +39,7 @@ OBJModel* loadOBJ(const char* filename) {
     model->indices = (int*)malloc(indexCapacity * sizeof(int));
     model->numVertices = 0;
     model->numIndices = 0;
+    model->faceNormals = NULL;
     
     // Parse file line by line
     char line[256];
@@ -119,6 +121,7 @@ OBJModel* loadOBJ(const char* filename) {
     // Compute model center and size
     model->center = getModelCenter(model);
     model->scale = getModelSize(model);
+    computeOBJFaceNormals(model);
     
     printf("Loaded: %d vertices, %d triangles\n", 
            model->numVertices, model->numIndices / 3);
@@ -130,6 +133,7 @@ void freeOBJModel(OBJModel* model) {
     if (model) {
         if (model->vertices) free(model->vertices);
         if (model->indices) free(model->indices);
+        if (model->faceNormals) free(model->faceNormals);
         free(model);
     }
 }
@@ -148,10 +152,70 @@ void printOBJInfo(const OBJModel* model) {
     printf("======================\n");
 }
 
+int computeOBJFaceNormals(OBJModel* model) {
+    if (!model) return 0;
+    
+    free(model->faceNormals);
+    model->faceNormals = NULL;
+    
+    int numFaces = model->numIndices / 3;
+    if (numFaces == 0) return 1;
+    
+    Vec3* normals = (Vec3*)malloc(numFaces * sizeof(Vec3));
+    Vec3* edges = (Vec3*)malloc(2 * (size_t)numFaces * sizeof(Vec3));
+    if (!normals || !edges) {
+        free(normals);
+        free(edges);
+        return 0;
+    }
+    
+    // Gather both edge vectors of every face, then cross and normalize in bulk
+    Vec3* edge1 = edges;
+    Vec3* edge2 = edges + numFaces;
+    for (int f = 0; f < numFaces; f++) {
+        int i1 = model->indices[3 * f];
+        int i2 = model->indices[3 * f + 1];
+        int i3 = model->indices[3 * f + 2];
+        
+        if (i1 < 0 || i1 >= model->numVertices ||
+            i2 < 0 || i2 >= model->numVertices ||
+            i3 < 0 || i3 >= model->numVertices) {
+            edge1[f] = edge2[f] = (Vec3){0.0, 0.0, 0.0};
+            continue;
+        }
+        
+        Vec3 v1 = model->vertices[i1];
+        Vec3 v2 = model->vertices[i2];
+        Vec3 v3 = model->vertices[i3];
+        edge1[f] = (Vec3){v2.x - v1.x, v2.y - v1.y, v2.z - v1.z};
+        edge2[f] = (Vec3){v3.x - v1.x, v3.y - v1.y, v3.z - v1.z};
+    }
+    
+    vec3_crossArray(edge1, edge2, normals, numFaces);
+    vec3_normalizeArrayFast(normals, normals, numFaces);
+    
+    free(edges);
+    model->faceNormals = normals;
+    return 1;
+}
+
 // ============================================================================
 // RENDERING FUNCTIONS
 // ============================================================================
 
+/**
+ * Unit normal of triangle i / 3 (precomputed when available)
+ */
+static Vec3 faceNormal(const OBJModel* model, int i, Vec3 v1, Vec3 v2, Vec3 v3) {
+    if (model->faceNormals) {
+        return model->faceNormals[i / 3];
+    }
+    
+    Vec3 edge1 = {v2.x - v1.x, v2.y - v1.y, v2.z - v1.z};
+    Vec3 edge2 = {v3.x - v1.x, v3.y - v1.y, v3.z - v1.z};
+    return bspline_normalize(bspline_cross(edge1, edge2));
+}
+
 void drawOBJModel(const OBJModel* model) {
     if (!model || !model->vertices || !model->indices) {
         return;
@@ -176,11 +240,8 @@ void drawOBJModel(const OBJModel* model) {
         Vec3 v2 = model->vertices[i2];
         Vec3 v3 = model->vertices[i3];
         
-        // Compute face normal for shading
-        Vec3 edge1 = {v2.x - v1.x, v2.y - v1.y, v2.z - v1.z};
-        Vec3 edge2 = {v3.x - v1.x, v3.y - v1.y, v3.z - v1.z};
-        Vec3 normal = bspline_cross(edge1, edge2);
-        normal = bspline_normalize(normal);
+        // Face normal for shading
+        Vec3 normal = faceNormal(model, i, v1, v2, v3);
         
         glNormal3f(normal.x, normal.y, normal.z);
         glVertex3f(v1.x, v1.y, v1.z);
@@ -233,11 +294,7 @@ void drawOBJModelWithNormals(const OBJModel* model, float normalLength) {
             (v1.z + v2.z + v3.z) / 3.0
         };
         
-        // Compute normal
-        Vec3 edge1 = {v2.x - v1.x, v2.y - v1.y, v2.z - v1.z};
-        Vec3 edge2 = {v3.x - v1.x, v3.y - v1.y, v3.z - v1.z};
-        Vec3 normal = bspline_cross(edge1, edge2);
-        normal = bspline_normalize(normal);
+        Vec3 normal = faceNormal(model, i, v1, v2, v3);
         
         // Draw normal line
         glVertex3f(center.x, center.y, center.z);
@@ -336,4 +393,8 @@ void normalizeModel(OBJModel* model) {
     // Update model info
     model->center = (Vec3){0.0, 0.0, 0.0};
     model->scale = 2.0f;
+    
+    // Uniform scale keeps directions, but faces that were too small to
+    // normalize may now have a normal
+    computeOBJFaceNormals(model);
 }
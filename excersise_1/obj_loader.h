@@ -21,6 +21,8 @@ typedef struct {
     int* indices;          // Array of vertex indices for triangles
     int numIndices;        // Number of indices (numTriangles * 3)
     
+    Vec3* faceNormals;     // Unit normal per triangle (numIndices / 3), or NULL
+    
     Vec3 center;           // Model center (for centering)
     float scale;           // Suggested scale factor
 } OBJModel;
@@ -56,6 +58,19 @@ void freeOBJModel(OBJModel* model);
  */
 void printOBJInfo(const OBJModel* model);
 
+/**
+ * (Re)compute per-triangle unit normals
+ * 
+ * All faces are done in one pass with the batched vector kernels
+ * (vec3_batch.h) instead of a cross product and normalize per triangle
+ * per frame. Triangles with invalid indices get a zero normal.
+ * Called by loadOBJ and normalizeModel.
+ * 
+ * @param model Model to update
+ * @return 1 on success, 0 on allocation failure (faceNormals left NULL)
+ */
+int computeOBJFaceNormals(OBJModel* model);
+
 // ============================================================================
 // RENDERING FUNCTIONS
 // ============================================================================
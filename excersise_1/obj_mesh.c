@@ -0,0 +1,234 @@
+#include "obj_mesh.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define GL_GLEXT_PROTOTYPES
+#ifdef __APPLE__
+    #include <GLUT/glut.h>
+    #include <OpenGL/glext.h>
+#else
+    #include <GL/glut.h>
+    #include <GL/glext.h>
+#endif
+
+// Normals are snapped to this grid so that faces which are coplanar up to
+// rounding share their corners (far below what lighting can show)
+#define NORMAL_QUANTUM (1.0 / 65536.0)
+
+// ============================================================================
+// UPLOAD
+// ============================================================================
+
+/**
+ * Buffer objects are core since OpenGL 1.5
+ */
+static int buffersAvailable(void) {
+    const char* version = (const char*)glGetString(GL_VERSION);
+    int major = 0, minor = 0;
+    if (!version || sscanf(version, "%d.%d", &major, &minor) != 2) return 0;
+    return major > 1 || (major == 1 && minor >= 5);
+}
+
+/**
+ * Corner lookup: open-addressing hash from vertex contents to vertex index
+ */
+typedef struct {
+    int* slots;    // Vertex index, or -1 for an empty slot
+    size_t mask;   // Slot count - 1 (power of two)
+} VertexTable;
+
+static size_t hashVertex(const float* v) {
+    // FNV-1a over the bytes of the 6 floats
+    const unsigned char* bytes = (const unsigned char*)v;
+    size_t hash = 2166136261u;
+    for (size_t i = 0; i < OBJMESH_VERTEX_FLOATS * sizeof(float); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Index of an earlier vertex equal to v, or numVertices after appending v
+ */
+static int findOrAddVertex(VertexTable* table, float* vertices, int* numVertices, const float* v) {
+    size_t vertexBytes = OBJMESH_VERTEX_FLOATS * sizeof(float);
+    for (size_t slot = hashVertex(v) & table->mask;; slot = (slot + 1) & table->mask) {
+        int index = table->slots[slot];
+        if (index < 0) {
+            index = (*numVertices)++;
+            memcpy(vertices + OBJMESH_VERTEX_FLOATS * (size_t)index, v, vertexBytes);
+            table->slots[slot] = index;
+            return index;
+        }
+        if (memcmp(vertices + OBJMESH_VERTEX_FLOATS * (size_t)index, v, vertexBytes) == 0) {
+            return index;
+        }
+    }
+}
+
+/**
+ * Convert triangles to interleaved float vertices, dropping bad ones
+ *
+ * Corners with the same position and (snapped) normal, e.g. shared by
+ * coplanar neighbouring faces, become one vertex.
+ *
+ * @return Number of indices written (3 per kept triangle)
+ */
+static int buildVertices(const OBJModel* model, VertexTable* table, float* outVertices, GLuint* outIndices,
+                         int* outNumVertices, int* outDropped) {
+    int numTriangles = model->numIndices / 3;
+    int numVertices = 0;
+    int numIndices = 0;
+    int dropped = 0;
+
+    for (int tri = 0; tri < numTriangles; tri++) {
+        const int* corner = &model->indices[3 * tri];
+        if (corner[0] < 0 || corner[0] >= model->numVertices ||
+            corner[1] < 0 || corner[1] >= model->numVertices ||
+            corner[2] < 0 || corner[2] >= model->numVertices) {
+            dropped++;
+            continue;
+        }
+
+        Vec3 normal;
+        if (model->faceNormals) {
+            normal = model->faceNormals[tri];
+        } else {
+            Vec3 a = model->vertices[corner[0]];
+            Vec3 b = model->vertices[corner[1]];
+            Vec3 c = model->vertices[corner[2]];
+            Vec3 edge1 = {b.x - a.x, b.y - a.y, b.z - a.z};
+            Vec3 edge2 = {c.x - a.x, c.y - a.y, c.z - a.z};
+            normal = bspline_normalize(bspline_cross(edge1, edge2));
+        }
+
+        for (int k = 0; k < 3; k++) {
+            Vec3 p = model->vertices[corner[k]];
+            float v[OBJMESH_VERTEX_FLOATS] = {
+                (float)p.x, (float)p.y, (float)p.z,
+                (float)(floor(normal.x / NORMAL_QUANTUM + 0.5) * NORMAL_QUANTUM),
+                (float)(floor(normal.y / NORMAL_QUANTUM + 0.5) * NORMAL_QUANTUM),
+                (float)(floor(normal.z / NORMAL_QUANTUM + 0.5) * NORMAL_QUANTUM)
+            };
+            outIndices[numIndices++] = (GLuint)findOrAddVertex(table, outVertices, &numVertices, v);
+        }
+    }
+
+    *outNumVertices = numVertices;
+    *outDropped = dropped;
+    return numIndices;
+}
+
+OBJMesh* createOBJMesh(const OBJModel* model) {
+    if (!model || !model->vertices || !model->indices || model->numIndices < 3) {
+        fprintf(stderr, "Error: No triangles to upload\n");
+        return NULL;
+    }
+
+    // At most one vertex per corner; the table stays at most half full
+    size_t maxCorners = (size_t)(model->numIndices / 3) * 3;
+    VertexTable table;
+    table.mask = 1;
+    while (table.mask + 1 < 2 * maxCorners) table.mask = 2 * table.mask + 1;
+
+    OBJMesh* mesh = (OBJMesh*)calloc(1, sizeof(OBJMesh));
+    float* vertices = (float*)malloc(maxCorners * OBJMESH_VERTEX_FLOATS * sizeof(float));
+    GLuint* indices = (GLuint*)malloc(maxCorners * sizeof(GLuint) + 1);  // Non-empty even if all were dropped
+    table.slots = (int*)malloc((table.mask + 1) * sizeof(int));
+    if (!mesh || !vertices || !indices || !table.slots) {
+        free(mesh);
+        free(vertices);
+        free(indices);
+        free(table.slots);
+        return NULL;
+    }
+    memset(table.slots, 0xff, (table.mask + 1) * sizeof(int));
+
+    mesh->numIndices = buildVertices(model, &table, vertices, indices,
+                                     &mesh->numVertices, &mesh->droppedTriangles);
+    free(table.slots);
+    if (mesh->droppedTriangles > 0) {
+        fprintf(stderr, "Warning: Dropped %d triangles with invalid indices\n", mesh->droppedTriangles);
+    }
+
+    // 16-bit indices when they fit
+    size_t indexSize = sizeof(GLuint);
+    mesh->indexType = GL_UNSIGNED_INT;
+    GLushort* shortIndices = (mesh->numVertices <= 65536)
+        ? (GLushort*)malloc((size_t)mesh->numIndices * sizeof(GLushort) + 1) : NULL;
+    if (shortIndices) {
+        for (int i = 0; i < mesh->numIndices; i++) shortIndices[i] = (GLushort)indices[i];
+        free(indices);
+        indices = (GLuint*)shortIndices;
+        indexSize = sizeof(GLushort);
+        mesh->indexType = GL_UNSIGNED_SHORT;
+    }
+
+    if (!buffersAvailable()) {
+        mesh->clientVertices = vertices;
+        mesh->clientIndices = indices;
+        return mesh;
+    }
+
+    glGenBuffers(1, &mesh->vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER,
+                 (GLsizeiptr)mesh->numVertices * OBJMESH_VERTEX_FLOATS * sizeof(float),
+                 vertices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenBuffers(1, &mesh->indexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)mesh->numIndices * indexSize,
+                 indices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    free(vertices);
+    free(indices);
+    return mesh;
+}
+
+void freeOBJMesh(OBJMesh* mesh) {
+    if (mesh) {
+        if (mesh->vertexBuffer) glDeleteBuffers(1, &mesh->vertexBuffer);
+        if (mesh->indexBuffer) glDeleteBuffers(1, &mesh->indexBuffer);
+        free(mesh->clientVertices);
+        free(mesh->clientIndices);
+        free(mesh);
+    }
+}
+
+// ============================================================================
+// DRAWING
+// ============================================================================
+
+void drawOBJMesh(const OBJMesh* mesh) {
+    if (!mesh || mesh->numIndices == 0) return;
+
+    // Offsets into the bound buffers, or pointers into the client arrays
+    const char* vertexBase = (const char*)mesh->clientVertices;
+    const char* indexBase = (const char*)mesh->clientIndices;
+    GLsizei stride = OBJMESH_VERTEX_FLOATS * sizeof(float);
+
+    if (mesh->vertexBuffer) {
+        glBindBuffer(GL_ARRAY_BUFFER, mesh->vertexBuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->indexBuffer);
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glVertexPointer(3, GL_FLOAT, stride, vertexBase);
+    glNormalPointer(GL_FLOAT, stride, vertexBase + OBJMESH_NORMAL_OFFSET * sizeof(float));
+
+    glDrawElements(GL_TRIANGLES, mesh->numIndices, mesh->indexType, indexBase);
+
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    if (mesh->vertexBuffer) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef OBJ_MESH_H
+#define OBJ_MESH_H
+
+#include "obj_loader.h"
+
+// ============================================================================
+// RETAINED-MODE OBJ MESH
+// An OBJModel converted once into GPU buffers: interleaved float
+// position/normal vertices and an index buffer. Indices are validated and
+// face normals converted at upload, so drawing is one glDrawElements call
+// with no per-triangle CPU work. Uses the fixed-function pipeline (vertex
+// and normal arrays), so lighting matches drawOBJModel.
+// ============================================================================
+
+#define OBJMESH_VERTEX_FLOATS 6    // x y z nx ny nz
+#define OBJMESH_NORMAL_OFFSET 3    // Floats before the normal
+
+/**
+ * Mesh in GPU buffers
+ *
+ * Flat shading needs the face normal at every corner, so a vertex is a
+ * (position, normal) pair. Corners with the same pair, such as those shared
+ * by coplanar neighbouring faces, are stored once and indexed. Without
+ * buffer objects (OpenGL < 1.5) the same arrays stay in client memory and
+ * are drawn from there.
+ */
+typedef struct {
+    unsigned int vertexBuffer;  // GL buffer of numVertices interleaved vertices, or 0
+    unsigned int indexBuffer;   // GL buffer of numIndices indices, or 0
+    unsigned int indexType;     // GL_UNSIGNED_SHORT when numVertices allows it, else GL_UNSIGNED_INT
+    int numVertices;
+    int numIndices;
+    int droppedTriangles;       // Triangles with out-of-range indices (not uploaded)
+
+    float* clientVertices;      // Client-side copies when buffers are unavailable, else NULL
+    void* clientIndices;
+} OBJMesh;
+
+/**
+ * Upload model (needs a current OpenGL context)
+ *
+ * The mesh is a copy: later changes to the model are not seen.
+ *
+ * @param model Model to upload
+ * @return Newly allocated mesh (free with freeOBJMesh), or NULL on error
+ */
+OBJMesh* createOBJMesh(const OBJModel* model);
+
+/**
+ * Free mesh and its GPU buffers (needs the same OpenGL context)
+ *
+ * @param mesh Mesh to free (NULL is allowed)
+ */
+void freeOBJMesh(OBJMesh* mesh);
+
+/**
+ * Draw mesh with the current transformation, color and material state
+ *
+ * Same picture as drawOBJModel on the source model, in one indexed draw call.
+ *
+ * @param mesh Mesh to draw
+ */
+void drawOBJMesh(const OBJMesh* mesh);
+
+#endif // OBJ_MESH_H
@@ -0,0 +1,290 @@
+#include "path_file.h"
+#include "file_io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Section alignment (cache line; also satisfies double alignment)
+#define PATHFILE_ALIGNMENT 64
+
+// Points converted per fwrite when narrowing to float32
+#define WRITE_CHUNK_POINTS 4096
+
+static uint64_t alignOffset(uint64_t offset) {
+    return (offset + PATHFILE_ALIGNMENT - 1) & ~(uint64_t)(PATHFILE_ALIGNMENT - 1);
+}
+
+static size_t pointSize(PathPrecision precision) {
+    return (precision == PATH_PRECISION_FLOAT32) ? 3 * sizeof(float) : 3 * sizeof(double);
+}
+
+// ============================================================================
+// MAPPING
+// ============================================================================
+
+/**
+ * Check header fields against the file size
+ */
+static int validateHeader(const PathFileHeader* h, size_t fileSize, const char* filename) {
+    if (memcmp(h->magic, PATHFILE_MAGIC, 8) != 0) {
+        fprintf(stderr, "Error: '%s' is not a binary path file\n", filename);
+        return 0;
+    }
+    if (h->byteOrder != PATHFILE_BYTE_ORDER) {
+        fprintf(stderr, "Error: '%s' was written with a different byte order\n", filename);
+        return 0;
+    }
+    if (h->version != PATHFILE_VERSION) {
+        fprintf(stderr, "Error: '%s' has unsupported version %u\n", filename, h->version);
+        return 0;
+    }
+    if (h->precision != PATH_PRECISION_FLOAT64 && h->precision != PATH_PRECISION_FLOAT32) {
+        fprintf(stderr, "Error: '%s' has unknown precision %u\n", filename, h->precision);
+        return 0;
+    }
+    if (h->numPoints > 0x7fffffff || h->numKnots > 0x7fffffff) {
+        fprintf(stderr, "Error: '%s' holds more points than supported\n", filename);
+        return 0;
+    }
+
+    // Offsets are bounded before any arithmetic, so crafted values cannot wrap
+    size_t size = pointSize((PathPrecision)h->precision);
+    if (h->pointsOffset < sizeof(PathFileHeader) || h->pointsOffset % PATHFILE_ALIGNMENT != 0 ||
+        h->pointsOffset > fileSize || h->numPoints > (fileSize - h->pointsOffset) / size) {
+        fprintf(stderr, "Error: '%s' point array is truncated or misplaced\n", filename);
+        return 0;
+    }
+    if (h->numKnots > 0) {
+        uint64_t pointsEnd = h->pointsOffset + h->numPoints * size;
+        if (h->knotsOffset < pointsEnd || h->knotsOffset % PATHFILE_ALIGNMENT != 0 ||
+            h->knotsOffset > fileSize || h->numKnots > (fileSize - h->knotsOffset) / sizeof(double)) {
+            fprintf(stderr, "Error: '%s' knot vector is truncated or misplaced\n", filename);
+            return 0;
+        }
+    }
+    return pathfile_checkCurveType(h, filename);
+}
+
+/**
+ * Uniform knot vector: strictly increasing with equal spacing
+ */
+static int knotsAreUniform(const double* knots, int numKnots) {
+    double step = knots[1] - knots[0];
+    if (!(step > 0.0)) return 0;
+    for (int i = 2; i < numKnots; i++) {
+        double d = knots[i] - knots[i - 1];
+        if (!(fabs(d - step) <= 1e-9 * step)) return 0;
+    }
+    return 1;
+}
+
+int pathfile_checkCurveType(const PathFileHeader* h, const char* filename) {
+    if (h->degree != 3) {
+        fprintf(stderr, "Error: '%s' has degree %u; only cubic paths are supported\n", filename, h->degree);
+        return 0;
+    }
+    if (h->numKnots != 0 && h->numKnots != h->numPoints + 4) {
+        fprintf(stderr, "Error: '%s' has %llu knots for %llu points (expected %llu)\n", filename,
+                (unsigned long long)h->numKnots, (unsigned long long)h->numPoints,
+                (unsigned long long)(h->numPoints + 4));
+        return 0;
+    }
+    return 1;
+}
+
+MappedPath* pathfile_open(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open path file '%s'\n", filename);
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(PathFileHeader)) {
+        fprintf(stderr, "Error: '%s' is too small for a path file\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void* data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map path file '%s'\n", filename);
+        return NULL;
+    }
+
+    const PathFileHeader* h = (const PathFileHeader*)data;
+    MappedPath* path = (MappedPath*)calloc(1, sizeof(MappedPath));
+    if (!path || !validateHeader(h, size, filename)) {
+        free(path);
+        munmap(data, size);
+        return NULL;
+    }
+
+    const char* base = (const char*)data;
+    path->header = h;
+    path->mappingSize = size;
+    path->precision = (PathPrecision)h->precision;
+    path->numPoints = (int)h->numPoints;
+    path->numKnots = (int)h->numKnots;
+    path->degree = (int)h->degree;
+    if (path->precision == PATH_PRECISION_FLOAT64) {
+        path->points = (const Vec3*)(base + h->pointsOffset);
+    } else {
+        path->pointsFloat = (const float*)(base + h->pointsOffset);
+    }
+    path->knots = (h->numKnots > 0) ? (const double*)(base + h->knotsOffset) : NULL;
+
+    if (path->knots && !knotsAreUniform(path->knots, path->numKnots)) {
+        fprintf(stderr, "Error: '%s' has non-uniform knots; only uniform paths are supported\n", filename);
+        pathfile_close(path);
+        return NULL;
+    }
+
+    return path;
+}
+
+void pathfile_close(MappedPath* path) {
+    if (path) {
+        if (path->header) munmap((void*)path->header, path->mappingSize);
+        free(path);
+    }
+}
+
+int pathfile_isPathFile(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return 0;
+
+    char magic[8];
+    int isPath = fread(magic, 1, 8, file) == 8 && memcmp(magic, PATHFILE_MAGIC, 8) == 0;
+    fclose(file);
+    return isPath;
+}
+
+// ============================================================================
+// WRITING
+// ============================================================================
+
+static int writePadding(FILE* file, uint64_t from, uint64_t to) {
+    static const char zeros[PATHFILE_ALIGNMENT] = {0};
+    return to - from <= PATHFILE_ALIGNMENT && fwrite(zeros, 1, (size_t)(to - from), file) == to - from;
+}
+
+int pathfile_write(const char* filename, const Vec3* points, int numPoints, PathPrecision precision,
+                   const double* knots, int numKnots, int degree) {
+    if (!points || numPoints <= 0) {
+        fprintf(stderr, "Error: No points to write\n");
+        return 0;
+    }
+    if (!knots) numKnots = 0;
+
+    PathFileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, PATHFILE_MAGIC, 8);
+    h.version = PATHFILE_VERSION;
+    h.byteOrder = PATHFILE_BYTE_ORDER;
+    h.precision = (uint32_t)precision;
+    h.degree = (uint32_t)degree;
+    h.numPoints = (uint64_t)numPoints;
+    h.numKnots = (uint64_t)numKnots;
+    h.pointsOffset = alignOffset(sizeof(PathFileHeader));
+    uint64_t pointsEnd = h.pointsOffset + h.numPoints * pointSize(precision);
+    h.knotsOffset = numKnots > 0 ? alignOffset(pointsEnd) : 0;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot create path file '%s'\n", filename);
+        return 0;
+    }
+
+    int ok = fwrite(&h, sizeof(h), 1, file) == 1 &&
+             writePadding(file, sizeof(h), h.pointsOffset);
+
+    if (ok && precision == PATH_PRECISION_FLOAT64) {
+        ok = fwrite(points, sizeof(Vec3), (size_t)numPoints, file) == (size_t)numPoints;
+    } else if (ok) {
+        float chunk[3 * WRITE_CHUNK_POINTS];
+        for (int first = 0; ok && first < numPoints; first += WRITE_CHUNK_POINTS) {
+            int count = numPoints - first < WRITE_CHUNK_POINTS ? numPoints - first : WRITE_CHUNK_POINTS;
+            for (int i = 0; i < count; i++) {
+                chunk[3 * i + 0] = (float)points[first + i].x;
+                chunk[3 * i + 1] = (float)points[first + i].y;
+                chunk[3 * i + 2] = (float)points[first + i].z;
+            }
+            ok = fwrite(chunk, 3 * sizeof(float), (size_t)count, file) == (size_t)count;
+        }
+    }
+
+    if (ok && numKnots > 0) {
+        ok = writePadding(file, pointsEnd, h.knotsOffset) &&
+             fwrite(knots, sizeof(double), (size_t)numKnots, file) == (size_t)numKnots;
+    }
+
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "Error: Failed writing path file '%s'\n", filename);
+        return 0;
+    }
+    return 1;
+}
+
+// ============================================================================
+// CONVERSION
+// ============================================================================
+
+const Vec3* pathfile_widenPoints(const MappedPath* path, Vec3** outWidened) {
+    *outWidened = NULL;
+    if (path->points) return path->points;
+
+    Vec3* widened = (Vec3*)malloc((size_t)path->numPoints * sizeof(Vec3));
+    if (!widened) return NULL;
+
+    for (int i = 0; i < path->numPoints; i++) {
+        widened[i].x = path->pointsFloat[3 * i + 0];
+        widened[i].y = path->pointsFloat[3 * i + 1];
+        widened[i].z = path->pointsFloat[3 * i + 2];
+    }
+    *outWidened = widened;
+    return widened;
+}
+
+Vec3* pathfile_readPoints(const char* filename, int* outCount) {
+    *outCount = 0;
+
+    MappedPath* path = pathfile_open(filename);
+    if (!path) return NULL;
+
+    // The caller owns the result, so FLOAT64 points are copied out of the mapping
+    Vec3* points;
+    const Vec3* mapped = pathfile_widenPoints(path, &points);
+    if (mapped && !points) {
+        points = (Vec3*)malloc((size_t)path->numPoints * sizeof(Vec3));
+        if (points) memcpy(points, mapped, (size_t)path->numPoints * sizeof(Vec3));
+    }
+    if (!points) {
+        fprintf(stderr, "Error: Out of memory reading '%s'\n", filename);
+        pathfile_close(path);
+        return NULL;
+    }
+
+    *outCount = path->numPoints;
+    pathfile_close(path);
+    printf("Loaded %d control points from %s\n", *outCount, filename);
+    return points;
+}
+
+int pathfile_convertText(const char* textFile, const char* pathFile, PathPrecision precision) {
+    int count;
+    Vec3* points = loadControlPoints(textFile, &count);
+    if (!points) return 0;
+
+    int ok = pathfile_write(pathFile, points, count, precision, NULL, 0, 3);
+    free(points);
+    return ok;
+}
@@ -0,0 +1,154 @@
+#ifndef PATH_FILE_H
+#define PATH_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "bspline.h"
+
+// ============================================================================
+// BINARY PATH FORMAT
+// Fixed 64-byte header followed by a packed point array (and optional knot
+// vector), all in native little-endian byte order:
+//
+//   offset 0               PathFileHeader
+//   header.pointsOffset    numPoints * 3 values (x, y, z per point)
+//   header.knotsOffset     numKnots doubles (only if numKnots > 0)
+//
+// Sections start on 64-byte boundaries, so a mapped float64 file is a valid
+// Vec3 array that the bspline_* evaluators can read in place.
+// ============================================================================
+
+#define PATHFILE_MAGIC "BSPLPATH"
+#define PATHFILE_VERSION 1
+#define PATHFILE_BYTE_ORDER 0x01020304u  // Reads differently on foreign-endian machines
+
+/**
+ * Storage precision of the point array
+ */
+typedef enum {
+    PATH_PRECISION_FLOAT64 = 0,  // 3 doubles per point (layout of Vec3)
+    PATH_PRECISION_FLOAT32 = 1   // 3 floats per point (half the size)
+} PathPrecision;
+
+/**
+ * On-disk header (64 bytes)
+ */
+typedef struct {
+    char magic[8];          // PATHFILE_MAGIC without terminator
+    uint32_t version;       // PATHFILE_VERSION
+    uint32_t byteOrder;     // PATHFILE_BYTE_ORDER
+    uint32_t precision;     // PathPrecision
+    uint32_t degree;        // Curve degree (3 for the uniform cubic B-spline)
+    uint64_t numPoints;     // Number of control points
+    uint64_t numKnots;      // Knot vector length (0 = uniform knots)
+    uint64_t pointsOffset;  // Byte offset of the point array
+    uint64_t knotsOffset;   // Byte offset of the knot vector (0 if none)
+    uint64_t reserved;      // Zero
+} PathFileHeader;
+
+/**
+ * Memory-mapped binary path (read-only)
+ */
+typedef struct {
+    const PathFileHeader* header;  // Start of the mapping
+    size_t mappingSize;
+    PathPrecision precision;
+    int numPoints;
+    int numKnots;
+    int degree;
+    const Vec3* points;            // Mapped points (FLOAT64 files), else NULL
+    const float* pointsFloat;      // Mapped xyz floats (FLOAT32 files), else NULL
+    const double* knots;           // Mapped knot vector, or NULL for uniform knots
+} MappedPath;
+
+/**
+ * Check that a header describes a curve the bspline_* evaluators handle
+ *
+ * The evaluators assume a uniform cubic B-spline, so the degree must be 3
+ * and a knot vector, if present, must hold numPoints + 4 knots. Spacing of
+ * the knots themselves is checked by pathfile_open once they are mapped.
+ *
+ * @param h Header
+ * @param filename File name for error messages
+ * @return 1 if supported, 0 otherwise (after printing an error)
+ */
+int pathfile_checkCurveType(const PathFileHeader* h, const char* filename);
+
+/**
+ * Map a binary path file
+ *
+ * Only the header (and the knot vector, which must be uniform) is
+ * validated and the points are not copied, so opening costs the same for
+ * any point count; pages are read on first access and shared
+ * through the page cache with every other process mapping the file.
+ *
+ * @param filename Path file
+ * @return Newly allocated mapping (close with pathfile_close), or NULL on error
+ */
+MappedPath* pathfile_open(const char* filename);
+
+/**
+ * Unmap path file
+ *
+ * @param path Mapping to close (NULL is allowed); pointers into it become invalid
+ */
+void pathfile_close(MappedPath* path);
+
+/**
+ * Check whether a file starts with the binary path magic
+ *
+ * @param filename File to check
+ * @return 1 for binary path files, 0 otherwise
+ */
+int pathfile_isPathFile(const char* filename);
+
+/**
+ * Write binary path file
+ *
+ * @param filename Output file
+ * @param points Control points
+ * @param numPoints Number of control points
+ * @param precision Storage precision
+ * @param knots Knot vector, or NULL for uniform knots
+ * @param numKnots Knot vector length (ignored if knots is NULL)
+ * @param degree Curve degree
+ * @return 1 on success, 0 on error
+ */
+int pathfile_write(const char* filename, const Vec3* points, int numPoints, PathPrecision precision,
+                   const double* knots, int numKnots, int degree);
+
+/**
+ * Points of a mapped path as Vec3
+ *
+ * FLOAT64 files are used in place; FLOAT32 files are widened into a new
+ * array that *outWidened receives (free it once the points are no longer
+ * used).
+ *
+ * @param path Mapped path
+ * @param outWidened Output: widened array to free, or NULL if the mapping was used
+ * @return Points (valid while path is mapped), or NULL if out of memory
+ */
+const Vec3* pathfile_widenPoints(const MappedPath* path, Vec3** outWidened);
+
+/**
+ * Copy points of a binary path file into a new array
+ *
+ * For callers that modify the points; read-only users should map the file.
+ *
+ * @param filename Path file
+ * @param outCount Output: number of control points (0 on error)
+ * @return Dynamically allocated array of Vec3 (caller must free with free()), or NULL on error
+ */
+Vec3* pathfile_readPoints(const char* filename, int* outCount);
+
+/**
+ * Convert text control point file (see loadControlPoints) to binary
+ *
+ * @param textFile Input text file
+ * @param pathFile Output binary path file
+ * @param precision Storage precision
+ * @return 1 on success, 0 on error
+ */
+int pathfile_convertText(const char* textFile, const char* pathFile, PathPrecision precision);
+
+#endif // PATH_FILE_H
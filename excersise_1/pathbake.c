@@ -0,0 +1,310 @@
+/*
+ * ============================================================================
+ * PATH BAKING TOOL (HEADLESS)
+ * ============================================================================
+ *
+ * Samples a control point path and writes one line per sample:
+ *
+ *   s  x y z  qw qx qy qz
+ *
+ * s is the distance along the curve, (x, y, z) the position and q the unit
+ * quaternion of the rotation exercise1 applies to the object at that point
+ * (quat_applyRotation(q) reproduces it). With --timestep the output is a
+ * binary track file (track_file.h) for evaluation-free playback instead.
+ * Links only the core library, so it runs on machines without OpenGL.
+ *
+ * Usage: ./pathbake input output [--rate N | --spacing D | --timestep DT [--speed V]]
+ *                   [--frame rmf|frenet|axis]
+ *
+ *   input        control points, text or binary path file
+ *   output       baked samples (text), or track file with --timestep
+ *   --rate N     samples per segment including both ends (default 16)
+ *   --spacing D  one sample every D units of arc length instead (constant speed)
+ *   --timestep DT  track file: one sample every DT seconds at V units/s (default 1)
+ *   --frame      orientation: rotation-minimizing frames (default), Frenet
+ *                frames, or shortest arc from +Z to the tangent (axis-angle mode)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bspline.h"
+#include "bspline_curve.h"
+#include "bspline_arclength.h"
+#include "bspline_rmf.h"
+#include "quaternion.h"
+#include "track_file.h"
+#include "file_io.h"
+#include "path_file.h"
+
+#define DEFAULT_RATE 16
+#define DEFAULT_SPEED 1.0
+
+// Same arc-length table resolution as exercise1
+#define ARC_SUBDIVISIONS 8
+
+/**
+ * Everything needed to orient a sample
+ *
+ * Samples are written in curve order, so rotation-minimizing frames are
+ * carried from one sample to the next instead of being looked up in a table.
+ */
+typedef struct {
+    const BSplineCurve* curve;
+    const ArcLengthTable* arcTable;
+    TrackFrame mode;
+    FILE* out;
+
+    long numWritten;
+    FrenetFrame rmf;            // FRAME_RMF: frame at the last sample
+    Vec3 rmfPosition;           // FRAME_RMF: position of the last sample
+} BakeContext;
+
+// ============================================================================
+// SAMPLING
+// ============================================================================
+
+static void writeSample(BakeContext* ctx, int segment, float t, double distance) {
+    Vec3 p;
+    Quat q;
+    if (ctx->mode == TRACK_FRAME_RMF) {
+        CurveJet jet = bspline_curveJet(ctx->curve, segment, t, NULL);
+        p = jet.position;
+        ctx->rmf = (ctx->numWritten == 0) ? bspline_startRMF(ctx->curve)
+                                          : bspline_stepRMF(ctx->rmf, ctx->rmfPosition, p, jet.tangent);
+        ctx->rmfPosition = p;
+
+        float matrix[16];
+        bspline_frenetToMatrix(ctx->rmf, matrix, 1);  // Same matrix as bspline_applyFrenetFrame
+        q = quat_fromMatrix(matrix);
+    } else {
+        q = track_orientation(ctx->curve, NULL, ctx->mode, segment, t, &p);
+    }
+    ctx->numWritten++;
+
+    fprintf(ctx->out, "%.9g  %.9g %.9g %.9g  %.9g %.9g %.9g %.9g\n", distance,
+            p.x, p.y, p.z, q.w, q.x, q.y, q.z);
+}
+
+/**
+ * Uniform in the curve parameter: t = 0, h, ..., 1 - h per segment plus the end point
+ */
+static long bakeByRate(BakeContext* ctx, int rate) {
+    int numSegments = ctx->curve->numSegments;
+    long count = 0;
+
+    for (int seg = 1; seg <= numSegments; seg++) {
+        for (int i = 0; i < rate - 1; i++) {
+            float t = (float)i / (float)(rate - 1);
+            writeSample(ctx, seg, t, bspline_parameterToArcLength(ctx->arcTable, seg, t));
+            count++;
+        }
+    }
+    writeSample(ctx, numSegments, 1.0f, ctx->arcTable->totalLength);
+    return count + 1;
+}
+
+/**
+ * Uniform in arc length: s = 0, D, 2D, ... plus the end point
+ */
+static long bakeBySpacing(BakeContext* ctx, double spacing) {
+    double total = ctx->arcTable->totalLength;
+    ArcLengthCursor cursor = {0};
+    long count = 0;
+
+    for (long i = 0; i * spacing < total; i++) {
+        double distance = i * spacing;
+        int segment;
+        float t;
+        bspline_arcLengthToParameterHinted(ctx->arcTable, distance, &cursor, &segment, &t);
+        writeSample(ctx, segment, t, distance);
+        count++;
+    }
+    writeSample(ctx, ctx->curve->numSegments, 1.0f, total);
+    return count + 1;
+}
+
+// ============================================================================
+// INPUT
+// ============================================================================
+
+/**
+ * Compile the input path into a curve
+ *
+ * Binary path files are mapped rather than read; float64 points are
+ * compiled straight from the mapping, float32 ones from a widened
+ * temporary copy. The compiled curve (216 bytes per segment, nine times
+ * the float64 points) is what the arc-length table and the frames are
+ * evaluated from, so this is not zero-copy. The curve keeps no pointer to
+ * the points, and the mapping is closed before returning.
+ */
+static BSplineCurve* loadCurve(const char* inputFile, int* outCount) {
+    *outCount = 0;
+
+    if (!pathfile_isPathFile(inputFile)) {
+        Vec3* points = loadControlPoints(inputFile, outCount);
+        if (!points) return NULL;
+        BSplineCurve* curve = bspline_compileCurve(points, *outCount);
+        free(points);
+        return curve;
+    }
+
+    MappedPath* path = pathfile_open(inputFile);
+    if (!path) return NULL;
+    *outCount = path->numPoints;
+
+    Vec3* widened;
+    const Vec3* points = pathfile_widenPoints(path, &widened);
+    if (!points) {
+        fprintf(stderr, "Error: Out of memory reading '%s'\n", inputFile);
+        pathfile_close(path);
+        return NULL;
+    }
+
+    printf("Mapped %d control points from %s\n", path->numPoints, inputFile);
+    BSplineCurve* curve = bspline_compileCurve(points, path->numPoints);
+    free(widened);
+    pathfile_close(path);
+    return curve;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s input output [--rate N | --spacing D | --timestep DT [--speed V]]\n"
+                    "       %*s [--frame rmf|frenet|axis]\n",
+            program, (int)strlen(program), "");
+}
+
+static const char* frameName(TrackFrame mode) {
+    switch (mode) {
+        case TRACK_FRAME_FRENET: return "frenet";
+        case TRACK_FRAME_AXIS:   return "axis";
+        default:                 return "rmf";
+    }
+}
+
+/**
+ * Text output (--rate / --spacing)
+ */
+static int writeText(BakeContext* ctx, int rate, double spacing,
+                     const char* inputFile, int numControlPoints, const char* outputFile) {
+    ctx->out = fopen(outputFile, "w");
+    if (!ctx->out) {
+        fprintf(stderr, "Error: Cannot open '%s' for writing\n", outputFile);
+        return 0;
+    }
+
+    fprintf(ctx->out, "# pathbake: %s, %d control points, %s frames, length %.9g\n",
+            inputFile, numControlPoints, frameName(ctx->mode), ctx->arcTable->totalLength);
+    fprintf(ctx->out, "# s x y z qw qx qy qz\n");
+
+    long count = (spacing > 0.0) ? bakeBySpacing(ctx, spacing) : bakeByRate(ctx, rate);
+
+    int failed = ferror(ctx->out);
+    if (fclose(ctx->out) != 0) failed = 1;
+    if (failed) {
+        fprintf(stderr, "Error: Failed to write '%s'\n", outputFile);
+        return 0;
+    }
+    printf("Wrote %ld samples to %s\n", count, outputFile);
+    return 1;
+}
+
+/**
+ * Track file output (--timestep)
+ */
+static int writeTrack(const BakeContext* ctx, double speed, double timestep, const char* outputFile) {
+    Track* track = track_bake(ctx->curve, ctx->arcTable, NULL, ctx->mode, speed, timestep);
+    if (!track) return 0;
+
+    int ok = track_write(track, outputFile);
+    if (ok) {
+        printf("Wrote %d samples (%.3f s at %g units/s, %s frames) to %s\n", track->numSamples,
+               track->duration, speed, frameName(ctx->mode), outputFile);
+    }
+    track_free(track);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const char* inputFile = argv[1];
+    const char* outputFile = argv[2];
+    int rate = DEFAULT_RATE;
+    double spacing = 0.0;
+    double timestep = 0.0;
+    double speed = DEFAULT_SPEED;
+    TrackFrame mode = TRACK_FRAME_RMF;
+
+    for (int i = 3; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!value) {
+            usage(argv[0]);
+            return 1;
+        }
+        if (strcmp(argv[i], "--rate") == 0) {
+            rate = atoi(value);
+        } else if (strcmp(argv[i], "--spacing") == 0) {
+            spacing = atof(value);
+            if (spacing <= 0.0) {
+                fprintf(stderr, "Error: Spacing must be positive\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--timestep") == 0) {
+            timestep = atof(value);
+            if (timestep <= 0.0) {
+                fprintf(stderr, "Error: Timestep must be positive\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--speed") == 0) {
+            speed = atof(value);
+            if (speed <= 0.0) {
+                fprintf(stderr, "Error: Speed must be positive\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--frame") == 0) {
+            if (strcmp(value, "rmf") == 0) mode = TRACK_FRAME_RMF;
+            else if (strcmp(value, "frenet") == 0) mode = TRACK_FRAME_FRENET;
+            else if (strcmp(value, "axis") == 0) mode = TRACK_FRAME_AXIS;
+            else {
+                fprintf(stderr, "Error: Unknown frame mode '%s'\n", value);
+                return 1;
+            }
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+
+    if (rate < 2) {
+        fprintf(stderr, "Error: Rate must be at least 2 samples per segment\n");
+        return 1;
+    }
+
+    int numControlPoints = 0;
+    BSplineCurve* curve = loadCurve(inputFile, &numControlPoints);
+    ArcLengthTable* arcTable = curve ? bspline_buildArcLengthTable(curve, ARC_SUBDIVISIONS) : NULL;
+    if (!curve || !arcTable) {
+        fprintf(stderr, "Error: Cannot bake path with %d control points\n", numControlPoints);
+        bspline_freeArcLengthTable(arcTable);
+        bspline_freeCurve(curve);
+        return 1;
+    }
+
+    BakeContext ctx = {curve, arcTable, mode, NULL, 0, {{0}}, {0.0, 0.0, 0.0}};
+    int ok = (timestep > 0.0) ? writeTrack(&ctx, speed, timestep, outputFile)
+                              : writeText(&ctx, rate, spacing, inputFile, numControlPoints, outputFile);
+
+    bspline_freeArcLengthTable(arcTable);
+    bspline_freeCurve(curve);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,30 @@
+/*
+ * ============================================================================
+ * TEXT TO BINARY PATH CONVERTER
+ * ============================================================================
+ *
+ * Converts a control point text file ("x y z" per line, see
+ * loadControlPoints) into the binary path format of path_file.h.
+ *
+ * Usage: ./pathconvert input.txt output.bspl [--float32]
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "path_file.h"
+
+int main(int argc, char** argv) {
+    if (argc < 3 || (argc > 3 && strcmp(argv[3], "--float32") != 0)) {
+        fprintf(stderr, "Usage: %s input.txt output.bspl [--float32]\n", argv[0]);
+        return 1;
+    }
+
+    PathPrecision precision = (argc > 3) ? PATH_PRECISION_FLOAT32 : PATH_PRECISION_FLOAT64;
+    if (!pathfile_convertText(argv[1], argv[2], precision)) {
+        return 1;
+    }
+
+    printf("Wrote %s (%s)\n", argv[2], precision == PATH_PRECISION_FLOAT32 ? "float32" : "float64");
+    return 0;
+}
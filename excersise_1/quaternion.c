@@ -0,0 +1,272 @@
+#include "quaternion.h"
+#include "vec3_batch.h"
+#include <math.h>
+
+// Below this 1 - |cos| slerp is numerically identical to nlerp
+#define SLERP_NLERP_THRESHOLD 1e-4f
+
+// ============================================================================
+// CONSTRUCTION
+// ============================================================================
+
+Quat quat_identity(void) {
+    return (Quat){1.0f, 0.0f, 0.0f, 0.0f};
+}
+
+Quat quat_normalize(Quat q) {
+    float len2 = q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z;
+    if (len2 < 1e-20f) {
+        return quat_identity();
+    }
+    float inv = 1.0f / sqrtf(len2);
+    return (Quat){q.w * inv, q.x * inv, q.y * inv, q.z * inv};
+}
+
+Quat quat_fromTwoVectors(Vec3 from, Vec3 to) {
+    // Real part |a||b| + a.b = |a||b| (1 + cos φ) - half-angle without acos
+    double norms = sqrt(bspline_dot(from, from) * bspline_dot(to, to));
+    double w = norms + bspline_dot(from, to);
+
+    if (w < 1e-6 * norms) {
+        // Opposite directions: rotate 180° around any axis perpendicular to `from`
+        Vec3 axis = (fabs(from.x) < 0.9 * sqrt(bspline_dot(from, from)))
+            ? bspline_cross(from, (Vec3){1.0, 0.0, 0.0})
+            : bspline_cross(from, (Vec3){0.0, 1.0, 0.0});
+        return quat_normalize((Quat){0.0f, (float)axis.x, (float)axis.y, (float)axis.z});
+    }
+
+    Vec3 axis = bspline_cross(from, to);
+    return quat_normalize((Quat){(float)w, (float)axis.x, (float)axis.y, (float)axis.z});
+}
+
+Quat quat_fromMatrix(const float matrix[16]) {
+    // R(row, col) = matrix[col * 4 + row]
+    float r00 = matrix[0], r10 = matrix[1], r20 = matrix[2];
+    float r01 = matrix[4], r11 = matrix[5], r21 = matrix[6];
+    float r02 = matrix[8], r12 = matrix[9], r22 = matrix[10];
+
+    float trace = r00 + r11 + r22;
+    Quat q;
+
+    // Pick the largest diagonal term to keep the sqrt argument well away from 0
+    if (trace > 0.0f) {
+        float s = 2.0f * sqrtf(trace + 1.0f);
+        q.w = 0.25f * s;
+        q.x = (r21 - r12) / s;
+        q.y = (r02 - r20) / s;
+        q.z = (r10 - r01) / s;
+    } else if (r00 > r11 && r00 > r22) {
+        float s = 2.0f * sqrtf(1.0f + r00 - r11 - r22);
+        q.w = (r21 - r12) / s;
+        q.x = 0.25f * s;
+        q.y = (r01 + r10) / s;
+        q.z = (r02 + r20) / s;
+    } else if (r11 > r22) {
+        float s = 2.0f * sqrtf(1.0f + r11 - r00 - r22);
+        q.w = (r02 - r20) / s;
+        q.x = (r01 + r10) / s;
+        q.y = 0.25f * s;
+        q.z = (r12 + r21) / s;
+    } else {
+        float s = 2.0f * sqrtf(1.0f + r22 - r00 - r11);
+        q.w = (r10 - r01) / s;
+        q.x = (r02 + r20) / s;
+        q.y = (r12 + r21) / s;
+        q.z = 0.25f * s;
+    }
+
+    return quat_normalize(q);
+}
+
+void quat_toMatrix(Quat q, float matrix[16]) {
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    // Column 0
+    matrix[0] = 1.0f - 2.0f * (yy + zz);
+    matrix[1] = 2.0f * (xy + wz);
+    matrix[2] = 2.0f * (xz - wy);
+    matrix[3] = 0.0f;
+
+    // Column 1
+    matrix[4] = 2.0f * (xy - wz);
+    matrix[5] = 1.0f - 2.0f * (xx + zz);
+    matrix[6] = 2.0f * (yz + wx);
+    matrix[7] = 0.0f;
+
+    // Column 2
+    matrix[8] = 2.0f * (xz + wy);
+    matrix[9] = 2.0f * (yz - wx);
+    matrix[10] = 1.0f - 2.0f * (xx + yy);
+    matrix[11] = 0.0f;
+
+    // Column 3: no translation
+    matrix[12] = 0.0f;
+    matrix[13] = 0.0f;
+    matrix[14] = 0.0f;
+    matrix[15] = 1.0f;
+}
+
+// ============================================================================
+// INTERPOLATION
+// ============================================================================
+
+Quat quat_nlerp(Quat a, Quat b, float w) {
+    // q and -q are the same rotation - flip b to take the shorter arc
+    float d = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    float wb = (d < 0.0f) ? -w : w;
+    float wa = 1.0f - w;
+
+    return quat_normalize((Quat){
+        wa * a.w + wb * b.w,
+        wa * a.x + wb * b.x,
+        wa * a.y + wb * b.y,
+        wa * a.z + wb * b.z
+    });
+}
+
+Quat quat_slerp(Quat a, Quat b, float w) {
+    float d = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    float sign = 1.0f;
+    if (d < 0.0f) {
+        d = -d;
+        sign = -1.0f;
+    }
+
+    if (1.0f - d < SLERP_NLERP_THRESHOLD) {
+        return quat_nlerp(a, b, w);
+    }
+
+    float theta = acosf(d);
+    float invSin = 1.0f / sinf(theta);
+    float wa = sinf((1.0f - w) * theta) * invSin;
+    float wb = sign * sinf(w * theta) * invSin;
+
+    return (Quat){
+        wa * a.w + wb * b.w,
+        wa * a.x + wb * b.x,
+        wa * a.y + wb * b.y,
+        wa * a.z + wb * b.z
+    };
+}
+
+// ============================================================================
+// BATCHES
+// Rotations are handled in blocks: one straight-line loop computes the blend
+// weights (the shorter-arc flip is a select, not a branch), a second one
+// the unnormalized blend into SoA scratch, and vec3_rsqrtArray (SIMD on x86)
+// the reciprocal lengths. Each loop vectorizes; only slerp's acosf / sinf
+// stay per element.
+// ============================================================================
+
+#define QUAT_BLOCK 64
+
+/**
+ * out[i] = normalize(wa[i] a[i] + wb[i] b[i]) for one block (n <= QUAT_BLOCK)
+ */
+static void blendBlock(const Quat* a, const Quat* b, const float* wa, const float* wb, int n, Quat* out) {
+    float qw[QUAT_BLOCK], qx[QUAT_BLOCK], qy[QUAT_BLOCK], qz[QUAT_BLOCK];
+    float len2[QUAT_BLOCK], inv[QUAT_BLOCK];
+
+    for (int i = 0; i < n; i++) {
+        qw[i] = wa[i] * a[i].w + wb[i] * b[i].w;
+        qx[i] = wa[i] * a[i].x + wb[i] * b[i].x;
+        qy[i] = wa[i] * a[i].y + wb[i] * b[i].y;
+        qz[i] = wa[i] * a[i].z + wb[i] * b[i].z;
+        float l = qw[i] * qw[i] + qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i];
+        len2[i] = (l > 1e-20f) ? l : 1e-20f;  // Unit inputs never get close
+    }
+
+    vec3_rsqrtArray(len2, inv, n);
+
+    for (int i = 0; i < n; i++) {
+        out[i].w = qw[i] * inv[i];
+        out[i].x = qx[i] * inv[i];
+        out[i].y = qy[i] * inv[i];
+        out[i].z = qz[i] * inv[i];
+    }
+}
+
+/**
+ * nlerp weights: b is negated (wb < 0) when it lies in the other hemisphere
+ */
+static void nlerpWeights(const Quat* a, const Quat* b, const float* w, int n, float* wa, float* wb) {
+    for (int i = 0; i < n; i++) {
+        float d = a[i].w * b[i].w + a[i].x * b[i].x + a[i].y * b[i].y + a[i].z * b[i].z;
+        wa[i] = 1.0f - w[i];
+        wb[i] = (d < 0.0f) ? -w[i] : w[i];
+    }
+}
+
+/**
+ * slerp weights, falling back to the nlerp ones for nearly equal rotations
+ */
+static void slerpWeights(const Quat* a, const Quat* b, const float* w, int n, float* wa, float* wb) {
+    for (int i = 0; i < n; i++) {
+        float d = a[i].w * b[i].w + a[i].x * b[i].x + a[i].y * b[i].y + a[i].z * b[i].z;
+        float sign = (d < 0.0f) ? -1.0f : 1.0f;
+        float c = fminf(d * sign, 1.0f);
+        int near = (1.0f - c < SLERP_NLERP_THRESHOLD);
+
+        float theta = acosf(c);
+        float invSin = near ? 1.0f : 1.0f / sinf(theta);
+        wa[i] = near ? 1.0f - w[i] : sinf((1.0f - w[i]) * theta) * invSin;
+        wb[i] = sign * (near ? w[i] : sinf(w[i] * theta) * invSin);
+    }
+}
+
+void quat_nlerpBatch(const Quat* a, const Quat* b, const float* w, int count, Quat* out) {
+    if (!a || !b || !w || !out) return;
+
+    float wa[QUAT_BLOCK], wb[QUAT_BLOCK];
+    for (int first = 0; first < count; first += QUAT_BLOCK) {
+        int n = (count - first < QUAT_BLOCK) ? count - first : QUAT_BLOCK;
+        nlerpWeights(a + first, b + first, w + first, n, wa, wb);
+        blendBlock(a + first, b + first, wa, wb, n, out + first);
+    }
+}
+
+void quat_slerpBatch(const Quat* a, const Quat* b, const float* w, int count, Quat* out) {
+    if (!a || !b || !w || !out) return;
+
+    float wa[QUAT_BLOCK], wb[QUAT_BLOCK];
+    for (int first = 0; first < count; first += QUAT_BLOCK) {
+        int n = (count - first < QUAT_BLOCK) ? count - first : QUAT_BLOCK;
+        slerpWeights(a + first, b + first, w + first, n, wa, wb);
+        blendBlock(a + first, b + first, wa, wb, n, out + first);
+    }
+}
+
+void quat_sampleKeys(const Quat* keys, int numKeys, const double* positions, int count,
+                     int useSlerp, Quat* out) {
+    if (!keys || numKeys <= 0 || !positions || !out) return;
+
+    if (numKeys == 1) {
+        for (int i = 0; i < count; i++) out[i] = keys[0];
+        return;
+    }
+
+    // Gather each block's key pairs, then blend them like the batches above
+    Quat a[QUAT_BLOCK], b[QUAT_BLOCK];
+    float w[QUAT_BLOCK], wa[QUAT_BLOCK], wb[QUAT_BLOCK];
+    double last = (double)(numKeys - 1);
+    for (int first = 0; first < count; first += QUAT_BLOCK) {
+        int n = (count - first < QUAT_BLOCK) ? count - first : QUAT_BLOCK;
+        for (int i = 0; i < n; i++) {
+            // Clamped to [0, numKeys - 1]; the end key is pair numKeys - 2 at w = 1
+            double u = fmin(fmax(positions[first + i], 0.0), last);
+            int k = (int)u;
+            k = (k < numKeys - 2) ? k : numKeys - 2;
+            w[i] = (float)(u - k);
+            a[i] = keys[k];
+            b[i] = keys[k + 1];
+        }
+        if (useSlerp) {
+            slerpWeights(a, b, w, n, wa, wb);
+        } else {
+            nlerpWeights(a, b, w, n, wa, wb);
+        }
+        blendBlock(a, b, wa, wb, n, out + first);
+    }
+}
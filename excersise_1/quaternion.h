@@ -0,0 +1,133 @@
+#ifndef QUATERNION_H
+#define QUATERNION_H
+
+#include "bspline.h"
+
+// ============================================================================
+// UNIT QUATERNION ORIENTATION
+// Trig-free alternative to the axis-angle path (section 1.4):
+// no acos, no degree conversion, no sin/cos inside glRotatef.
+// ============================================================================
+
+// Rotation quaternion q = w + xi + yj + zk (unit length)
+typedef struct {
+    float w;
+    float x;
+    float y;
+    float z;
+} Quat;
+
+/**
+ * Identity rotation
+ *
+ * @return q = (1, 0, 0, 0)
+ */
+Quat quat_identity(void);
+
+/**
+ * Normalize quaternion to unit length
+ *
+ * @param q Input quaternion
+ * @return Unit quaternion (identity if q is ~0)
+ */
+Quat quat_normalize(Quat q);
+
+/**
+ * Shortest rotation taking direction `from` to direction `to`
+ *
+ * Same rotation as bspline_computeAxisAngle (equations 1.5 and 1.6) but
+ * built without trigonometry:
+ *   q = normalize(|a||b| + a.b, a x b)
+ * Inputs need not be normalized. Opposite vectors give a 180° turn about
+ * an axis perpendicular to `from`.
+ *
+ * @param from Start direction (e.g. {0, 0, 1})
+ * @param to Target direction (e.g. curve tangent)
+ * @return Unit quaternion
+ */
+Quat quat_fromTwoVectors(Vec3 from, Vec3 to);
+
+/**
+ * Quaternion from rotation matrix
+ *
+ * @param matrix 4x4 OpenGL column-major matrix (upper 3x3 must be a rotation)
+ * @return Unit quaternion
+ */
+Quat quat_fromMatrix(const float matrix[16]);
+
+/**
+ * Rotation matrix from quaternion (replaces glRotatef on the axis-angle path)
+ *
+ * @param q Unit quaternion
+ * @param matrix Output 4x4 matrix in OpenGL column-major format (16 floats)
+ */
+void quat_toMatrix(Quat q, float matrix[16]);
+
+/**
+ * Normalized linear interpolation along the shorter arc (trig-free)
+ *
+ * @param a Start rotation
+ * @param b End rotation
+ * @param w Blend weight in [0, 1]
+ * @return Unit quaternion between a and b
+ */
+Quat quat_nlerp(Quat a, Quat b, float w);
+
+/**
+ * Spherical linear interpolation along the shorter arc
+ *
+ * Constant angular velocity; falls back to nlerp for nearly equal inputs.
+ *
+ * @param a Start rotation
+ * @param b End rotation
+ * @param w Blend weight in [0, 1]
+ * @return Unit quaternion between a and b
+ */
+Quat quat_slerp(Quat a, Quat b, float w);
+
+/**
+ * Batched nlerp: out[i] = nlerp(a[i], b[i], w[i])
+ *
+ * Branch-free blocks normalized with vec3_rsqrtArray, so results agree
+ * with quat_nlerp to float precision rather than bit for bit.
+ *
+ * @param a Start rotations
+ * @param b End rotations
+ * @param w Blend weights
+ * @param count Number of rotations
+ * @param out Output rotations (may alias a or b)
+ */
+void quat_nlerpBatch(const Quat* a, const Quat* b, const float* w, int count, Quat* out);
+
+/**
+ * Batched slerp: out[i] = slerp(a[i], b[i], w[i])
+ *
+ * Same blocks as quat_nlerpBatch; only the acosf / sinf of the weights
+ * are per element.
+ *
+ * @param a Start rotations
+ * @param b End rotations
+ * @param w Blend weights
+ * @param count Number of rotations
+ * @param out Output rotations (may alias a or b)
+ */
+void quat_slerpBatch(const Quat* a, const Quat* b, const float* w, int count, Quat* out);
+
+/**
+ * Sample baked orientation keys at fractional key positions
+ *
+ * Position u in [0, numKeys - 1] blends keys floor(u) and floor(u) + 1.
+ * The key pairs of each block are gathered and blended like
+ * quat_nlerpBatch / quat_slerpBatch.
+ *
+ * @param keys Orientation keys (e.g. baked along a curve)
+ * @param numKeys Number of keys (>= 1)
+ * @param positions Fractional key positions (double, so long key arrays keep their fraction)
+ * @param count Number of samples
+ * @param useSlerp 1 for slerp, 0 for nlerp
+ * @param out Output rotations
+ */
+void quat_sampleKeys(const Quat* keys, int numKeys, const double* positions, int count,
+                     int useSlerp, Quat* out);
+
+#endif // QUATERNION_H
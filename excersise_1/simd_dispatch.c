@@ -0,0 +1,23 @@
+#include "simd_dispatch.h"
+#include <pthread.h>
+
+static pthread_once_t detectOnce = PTHREAD_ONCE_INIT;
+static SimdLevel cpuLevel = SIMD_LEVEL_SCALAR;
+
+static void detectLevel(void) {
+#if defined(SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        cpuLevel = SIMD_LEVEL_AVX2_FMA;
+    } else if (__builtin_cpu_supports("avx")) {
+        cpuLevel = SIMD_LEVEL_AVX;
+    } else if (__builtin_cpu_supports("sse2")) {
+        cpuLevel = SIMD_LEVEL_SSE2;
+    }
+#endif
+}
+
+SimdLevel simd_cpuLevel(void) {
+    pthread_once(&detectOnce, detectLevel);
+    return cpuLevel;
+}
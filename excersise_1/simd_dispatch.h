@@ -0,0 +1,36 @@
+#ifndef SIMD_DISPATCH_H
+#define SIMD_DISPATCH_H
+
+// ============================================================================
+// RUNTIME SIMD DISPATCH
+// Kernels are compiled for their own instruction set with SIMD_TARGET and
+// chosen at run time from simd_cpuLevel, so one binary runs on any x86-64
+// CPU without special compiler flags. Other targets use scalar kernels.
+// ============================================================================
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define SIMD_X86
+    #define SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+/**
+ * Instruction set levels, each including the ones before it
+ */
+typedef enum {
+    SIMD_LEVEL_SCALAR = 0,
+    SIMD_LEVEL_SSE2,
+    SIMD_LEVEL_AVX,
+    SIMD_LEVEL_AVX2_FMA
+} SimdLevel;
+
+/**
+ * Highest instruction set level the CPU supports
+ *
+ * Detected once on first call; safe to call from any thread.
+ *
+ * @return Supported level (SIMD_LEVEL_SCALAR on non-x86 targets)
+ */
+SimdLevel simd_cpuLevel(void);
+
+#endif // SIMD_DISPATCH_H
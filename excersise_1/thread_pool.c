@@ -0,0 +1,152 @@
+#include "thread_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct {
+    ThreadPool* pool;
+    int index;
+} WorkerInfo;
+
+struct ThreadPool {
+    pthread_t* threads;        // numWorkers - 1 background threads
+    WorkerInfo* workers;       // Per-thread start arguments
+    int numWorkers;            // Including the calling thread
+
+    pthread_mutex_t mutex;
+    pthread_cond_t startCond;  // Signalled when a new task is published
+    pthread_cond_t doneCond;   // Signalled when the last worker finishes
+
+    ThreadPoolTask task;
+    void* context;
+    unsigned long generation;  // Incremented for every published task
+    int pending;               // Background workers still running the task
+    int shutdown;
+};
+
+// ============================================================================
+// WORKER LOOP
+// ============================================================================
+
+static void* workerMain(void* arg) {
+    WorkerInfo* info = (WorkerInfo*)arg;
+    ThreadPool* pool = info->pool;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (pool->generation == seen && !pool->shutdown) {
+            pthread_cond_wait(&pool->startCond, &pool->mutex);
+        }
+        if (pool->shutdown) break;
+
+        seen = pool->generation;
+        ThreadPoolTask task = pool->task;
+        void* context = pool->context;
+        pthread_mutex_unlock(&pool->mutex);
+
+        task(context, info->index, pool->numWorkers);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->doneCond);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+int threadpool_cpuCount(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+}
+
+ThreadPool* threadpool_create(int numThreads) {
+    if (numThreads <= 0) numThreads = threadpool_cpuCount();
+
+    ThreadPool* pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+
+    pool->numWorkers = numThreads;
+    pool->threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    pool->workers = (WorkerInfo*)malloc(numThreads * sizeof(WorkerInfo));
+    if (!pool->threads || !pool->workers) {
+        free(pool->threads);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->startCond, NULL);
+    pthread_cond_init(&pool->doneCond, NULL);
+
+    // Worker 0 is the caller of threadpool_run
+    for (int i = 1; i < numThreads; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        if (pthread_create(&pool->threads[i], NULL, workerMain, &pool->workers[i]) != 0) {
+            fprintf(stderr, "Error: Failed to start worker thread %d\n", i);
+            pool->numWorkers = i;  // Only join what was started
+            threadpool_free(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+void threadpool_run(ThreadPool* pool, ThreadPoolTask task, void* context) {
+    if (!pool || !task) return;
+
+    if (pool->numWorkers == 1) {
+        task(context, 0, 1);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->task = task;
+    pool->context = context;
+    pool->pending = pool->numWorkers - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->startCond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    task(context, 0, pool->numWorkers);
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->doneCond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+int threadpool_size(const ThreadPool* pool) {
+    return pool ? pool->numWorkers : 0;
+}
+
+void threadpool_free(ThreadPool* pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->startCond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int i = 1; i < pool->numWorkers; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->startCond);
+    pthread_cond_destroy(&pool->doneCond);
+    free(pool->threads);
+    free(pool->workers);
+    free(pool);
+}
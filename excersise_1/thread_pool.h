@@ -0,0 +1,61 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// ============================================================================
+// MINIMAL THREAD POOL (POSIX THREADS)
+// Persistent workers running one data-parallel task at a time.
+// ============================================================================
+
+/**
+ * Task run by every worker
+ *
+ * @param context User data passed to threadpool_run
+ * @param worker Worker index (0 to numWorkers - 1; 0 is the calling thread)
+ * @param numWorkers Total number of workers
+ */
+typedef void (*ThreadPoolTask)(void* context, int worker, int numWorkers);
+
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * Number of online CPUs
+ *
+ * @return CPU count (at least 1)
+ */
+int threadpool_cpuCount(void);
+
+/**
+ * Create thread pool
+ *
+ * The calling thread counts as worker 0, so numThreads - 1 threads are started.
+ *
+ * @param numThreads Number of workers (<= 0 uses threadpool_cpuCount())
+ * @return Newly allocated pool (free with threadpool_free), or NULL on error
+ */
+ThreadPool* threadpool_create(int numThreads);
+
+/**
+ * Run task on all workers and wait until every worker has finished
+ *
+ * @param pool Thread pool
+ * @param task Task to run
+ * @param context User data passed to the task
+ */
+void threadpool_run(ThreadPool* pool, ThreadPoolTask task, void* context);
+
+/**
+ * Number of workers in pool (including the calling thread)
+ *
+ * @param pool Thread pool
+ * @return Worker count
+ */
+int threadpool_size(const ThreadPool* pool);
+
+/**
+ * Stop workers and free pool
+ *
+ * @param pool Pool to free (NULL is allowed)
+ */
+void threadpool_free(ThreadPool* pool);
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,321 @@
+#include "track_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Samples whose rotations are blended with one quat_nlerpBatch call
+#define TRACK_BATCH 64
+
+// ============================================================================
+// BAKING
+// ============================================================================
+
+/**
+ * Rotation bspline_applyFrenetFrame applies for a frame
+ */
+static Quat frameRotation(FrenetFrame frame) {
+    float matrix[16];
+    bspline_frenetToMatrix(frame, matrix, 1);
+    return quat_fromMatrix(matrix);
+}
+
+Quat track_orientation(const BSplineCurve* curve, const RMFTable* rmfTable, TrackFrame frame,
+                       int segment, float t, Vec3* outPosition) {
+    FrenetFrame frenet;
+    CurveJet jet = bspline_curveJet(curve, segment, t, frame == TRACK_FRAME_FRENET ? &frenet : NULL);
+    if (outPosition) *outPosition = jet.position;
+
+    if (frame == TRACK_FRAME_AXIS) {
+        Vec3 startOrientation = {0.0, 0.0, 1.0};
+        return quat_fromTwoVectors(startOrientation, jet.tangent);
+    }
+
+    if (frame == TRACK_FRAME_RMF) {
+        frenet = bspline_sampleRMF(rmfTable, segment, t);
+    }
+    return frameRotation(frenet);
+}
+
+Track* track_bake(const BSplineCurve* curve, const ArcLengthTable* arcTable,
+                  const RMFTable* rmfTable, TrackFrame frame, double speed, double timestep) {
+    if (!curve || !arcTable || !(speed > 0.0) || !(timestep > 0.0)) {
+        fprintf(stderr, "Error: Invalid track bake parameters\n");
+        return NULL;
+    }
+
+    double total = arcTable->totalLength;
+    double step = speed * timestep;
+    double intervals = ceil(total / step);
+    if (intervals < 1.0) intervals = 1.0;
+    if (intervals >= INT_MAX) {
+        fprintf(stderr, "Error: Track would need more than %d samples\n", INT_MAX);
+        return NULL;
+    }
+    int numSamples = (int)intervals + 1;
+
+    Track* track = (Track*)calloc(1, sizeof(Track));
+    TrackSample* samples = (TrackSample*)malloc((size_t)numSamples * sizeof(TrackSample));
+    if (!track || !samples) {
+        free(track);
+        free(samples);
+        return NULL;
+    }
+
+    // Without a table, RMF frames are carried from sample to sample
+    int propagate = (frame == TRACK_FRAME_RMF && !rmfTable);
+    FrenetFrame rmf = {{0}};
+    if (propagate) rmf = bspline_startRMF(curve);
+    Vec3 position = {0.0, 0.0, 0.0};
+
+    ArcLengthCursor cursor = {0};
+    for (int k = 0; k < numSamples; k++) {
+        double distance = k * step;
+        if (distance > total) distance = total;
+
+        int segment;
+        float t;
+        bspline_arcLengthToParameterHinted(arcTable, distance, &cursor, &segment, &t);
+
+        Quat q;
+        if (propagate) {
+            CurveJet jet = bspline_curveJet(curve, segment, t, NULL);
+            if (k > 0) rmf = bspline_stepRMF(rmf, position, jet.position, jet.tangent);
+            position = jet.position;
+            q = frameRotation(rmf);
+        } else {
+            q = track_orientation(curve, rmfTable, frame, segment, t, &position);
+        }
+
+        // q and -q are the same rotation; keep neighbours in one hemisphere
+        if (k > 0) {
+            Quat p = samples[k - 1].rotation;
+            if (p.w * q.w + p.x * q.x + p.y * q.y + p.z * q.z < 0.0f) {
+                q = (Quat){-q.w, -q.x, -q.y, -q.z};
+            }
+        }
+
+        samples[k].x = (float)position.x;
+        samples[k].y = (float)position.y;
+        samples[k].z = (float)position.z;
+        samples[k].rotation = q;
+    }
+
+    track->samples = samples;
+    track->numSamples = numSamples;
+    track->timestep = timestep;
+    track->duration = (numSamples - 1) * timestep;
+    track->speed = speed;
+    track->frame = frame;
+    return track;
+}
+
+// ============================================================================
+// FILES
+// ============================================================================
+
+int track_write(const Track* track, const char* filename) {
+    if (!track || !track->samples || track->numSamples < 2) {
+        fprintf(stderr, "Error: No track to write\n");
+        return 0;
+    }
+
+    TrackFileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, TRACKFILE_MAGIC, 8);
+    h.version = TRACKFILE_VERSION;
+    h.byteOrder = TRACKFILE_BYTE_ORDER;
+    h.frame = (uint32_t)track->frame;
+    h.sampleSize = (uint32_t)sizeof(TrackSample);
+    h.numSamples = (uint64_t)track->numSamples;
+    h.timestep = track->timestep;
+    h.speed = track->speed;
+    h.samplesOffset = sizeof(TrackFileHeader);
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot create track file '%s'\n", filename);
+        return 0;
+    }
+
+    int ok = fwrite(&h, sizeof(h), 1, file) == 1 &&
+             fwrite(track->samples, sizeof(TrackSample), (size_t)track->numSamples, file) ==
+                 (size_t)track->numSamples;
+
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "Error: Failed writing track file '%s'\n", filename);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Check header fields against the file size
+ */
+static int validateHeader(const TrackFileHeader* h, size_t fileSize, const char* filename) {
+    if (memcmp(h->magic, TRACKFILE_MAGIC, 8) != 0) {
+        fprintf(stderr, "Error: '%s' is not a track file\n", filename);
+        return 0;
+    }
+    if (h->byteOrder != TRACKFILE_BYTE_ORDER) {
+        fprintf(stderr, "Error: '%s' was written with a different byte order\n", filename);
+        return 0;
+    }
+    if (h->version != TRACKFILE_VERSION || h->sampleSize != sizeof(TrackSample)) {
+        fprintf(stderr, "Error: '%s' has unsupported version %u\n", filename, h->version);
+        return 0;
+    }
+    if (h->frame > TRACK_FRAME_AXIS || !(h->timestep > 0.0) ||
+        h->numSamples < 2 || h->numSamples > INT_MAX) {
+        fprintf(stderr, "Error: '%s' has an invalid header\n", filename);
+        return 0;
+    }
+    // Bounded before any arithmetic, so crafted offsets cannot wrap
+    if (h->samplesOffset < sizeof(TrackFileHeader) || h->samplesOffset % sizeof(float) != 0 ||
+        h->samplesOffset > fileSize ||
+        h->numSamples > (fileSize - h->samplesOffset) / sizeof(TrackSample)) {
+        fprintf(stderr, "Error: '%s' sample array is truncated or misplaced\n", filename);
+        return 0;
+    }
+    return 1;
+}
+
+Track* track_open(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open track file '%s'\n", filename);
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(TrackFileHeader)) {
+        fprintf(stderr, "Error: '%s' is too small for a track file\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void* data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map track file '%s'\n", filename);
+        return NULL;
+    }
+
+    const TrackFileHeader* h = (const TrackFileHeader*)data;
+    Track* track = (Track*)calloc(1, sizeof(Track));
+    if (!track || !validateHeader(h, size, filename)) {
+        free(track);
+        munmap(data, size);
+        return NULL;
+    }
+
+    track->samples = (const TrackSample*)((const char*)data + h->samplesOffset);
+    track->numSamples = (int)h->numSamples;
+    track->timestep = h->timestep;
+    track->duration = (track->numSamples - 1) * h->timestep;
+    track->speed = h->speed;
+    track->frame = (TrackFrame)h->frame;
+    track->mapping = data;
+    track->mappingSize = size;
+    return track;
+}
+
+int track_isTrackFile(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return 0;
+
+    char magic[8];
+    int isTrack = fread(magic, 1, 8, file) == 8 && memcmp(magic, TRACKFILE_MAGIC, 8) == 0;
+    fclose(file);
+    return isTrack;
+}
+
+void track_free(Track* track) {
+    if (track) {
+        if (track->mapping) {
+            munmap(track->mapping, track->mappingSize);
+        } else {
+            free((void*)track->samples);
+        }
+        free(track);
+    }
+}
+
+// ============================================================================
+// PLAYBACK
+// ============================================================================
+
+/**
+ * Sample pair around a time: returns the blend weight, *outFirst the first sample
+ *
+ * Clamped times before the start or after the end give weight 0 on the
+ * first or last sample.
+ */
+static float sampleInterval(const Track* track, double time, int loop, const TrackSample** outFirst) {
+    if (loop) {
+        time -= floor(time / track->duration) * track->duration;  // Cheaper than fmod
+    } else if (time <= 0.0) {
+        *outFirst = &track->samples[0];
+        return 0.0f;
+    } else if (time >= track->duration) {
+        *outFirst = &track->samples[track->numSamples - 1];
+        return 0.0f;
+    }
+
+    double u = time / track->timestep;
+    int k = (int)u;
+    if (k > track->numSamples - 2) k = track->numSamples - 2;
+    *outFirst = &track->samples[k];
+    return (float)(u - k);
+}
+
+TrackSample track_sample(const Track* track, double time, int loop) {
+    const TrackSample* a;
+    float w = sampleInterval(track, time, loop, &a);
+    if (w == 0.0f) return *a;
+
+    const TrackSample* b = a + 1;
+    TrackSample out;
+    out.x = a->x + w * (b->x - a->x);
+    out.y = a->y + w * (b->y - a->y);
+    out.z = a->z + w * (b->z - a->z);
+    out.rotation = quat_nlerp(a->rotation, b->rotation, w);
+    return out;
+}
+
+void track_sampleBatch(const Track* track, const double* times, int count, int loop,
+                       TrackSample* out) {
+    Quat from[TRACK_BATCH], to[TRACK_BATCH], rotations[TRACK_BATCH];
+    float weights[TRACK_BATCH];
+
+    for (int block = 0; block < count; block += TRACK_BATCH) {
+        int n = (count - block < TRACK_BATCH) ? count - block : TRACK_BATCH;
+
+        // Lerp positions and gather the rotation pairs of the whole block
+        for (int i = 0; i < n; i++) {
+            const TrackSample* a;
+            float w = sampleInterval(track, times[block + i], loop, &a);
+            const TrackSample* b = (w > 0.0f) ? a + 1 : a;
+
+            TrackSample* o = &out[block + i];
+            o->x = a->x + w * (b->x - a->x);
+            o->y = a->y + w * (b->y - a->y);
+            o->z = a->z + w * (b->z - a->z);
+            from[i] = a->rotation;
+            to[i] = b->rotation;
+            weights[i] = w;
+        }
+
+        quat_nlerpBatch(from, to, weights, n, rotations);
+        for (int i = 0; i < n; i++) {
+            out[block + i].rotation = rotations[i];
+        }
+    }
+}
@@ -0,0 +1,184 @@
+#ifndef TRACK_FILE_H
+#define TRACK_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "bspline.h"
+#include "bspline_curve.h"
+#include "bspline_arclength.h"
+#include "bspline_rmf.h"
+#include "quaternion.h"
+
+// ============================================================================
+// BAKED TRAJECTORY TRACKS
+// Position and orientation sampled at a fixed timestep while moving along
+// the curve at constant speed. Playback is one lerp (position) and one nlerp
+// (rotation) between neighbouring samples - no spline or frame math.
+//
+// File layout (native little-endian, like path_file.h):
+//
+//   offset 0                  TrackFileHeader (64 bytes)
+//   header.samplesOffset      numSamples TrackSample records
+// ============================================================================
+
+#define TRACKFILE_MAGIC "BSPLTRAK"
+#define TRACKFILE_VERSION 1
+#define TRACKFILE_BYTE_ORDER 0x01020304u
+
+/**
+ * Orientation stored in a track (same choices as the viewer)
+ */
+typedef enum {
+    TRACK_FRAME_RMF = 0,   // Rotation-minimizing frames
+    TRACK_FRAME_FRENET,    // Frenet-Serret frames (equations 1.7 - 1.9)
+    TRACK_FRAME_AXIS       // Shortest rotation from +Z to the tangent (section 1.4)
+} TrackFrame;
+
+/**
+ * One sample (28 bytes)
+ *
+ * rotation is the rotation the viewer applies at this point, so
+ * glTranslatef(position) + quat_applyRotation(rotation) places the object.
+ * Consecutive rotations lie in the same hemisphere (dot >= 0).
+ */
+typedef struct {
+    float x, y, z;
+    Quat rotation;
+} TrackSample;
+
+/**
+ * On-disk header (64 bytes)
+ */
+typedef struct {
+    char magic[8];           // TRACKFILE_MAGIC without terminator
+    uint32_t version;        // TRACKFILE_VERSION
+    uint32_t byteOrder;      // TRACKFILE_BYTE_ORDER
+    uint32_t frame;          // TrackFrame of the rotations
+    uint32_t sampleSize;     // sizeof(TrackSample)
+    uint64_t numSamples;     // Number of samples (>= 2)
+    double timestep;         // Seconds between samples
+    double speed;            // Units per second the track was baked at
+    uint64_t samplesOffset;  // Byte offset of the sample array
+    uint64_t reserved;       // Zero
+} TrackFileHeader;
+
+/**
+ * Track in memory - baked in place or mapped from a file
+ */
+typedef struct {
+    const TrackSample* samples;
+    int numSamples;
+    double timestep;         // Seconds between samples
+    double duration;         // (numSamples - 1) * timestep
+    double speed;            // Units per second
+    TrackFrame frame;
+
+    void* mapping;           // File mapping (track_open), or NULL
+    size_t mappingSize;
+} Track;
+
+// ============================================================================
+// BAKING
+// ============================================================================
+
+/**
+ * Position and orientation at (segment, t)
+ *
+ * The rotation is what the viewer applies for the given frame mode:
+ * quaternion of the bspline_applyFrenetFrame matrix (RMF, Frenet), or
+ * quat_fromTwoVectors({0, 0, 1}, tangent) (axis).
+ *
+ * @param curve Compiled curve
+ * @param rmfTable Rotation-minimizing frames (TRACK_FRAME_RMF only, else NULL)
+ * @param frame Orientation mode
+ * @param segment Segment index (1 to n-3)
+ * @param t Parameter in [0, 1]
+ * @param outPosition Output position (may be NULL)
+ * @return Unit quaternion
+ */
+Quat track_orientation(const BSplineCurve* curve, const RMFTable* rmfTable, TrackFrame frame,
+                       int segment, float t, Vec3* outPosition);
+
+/**
+ * Sample curve at a fixed timestep, moving at constant speed
+ *
+ * Sample k is at distance min(k * speed * timestep, length); the last
+ * sample is the curve end point.
+ *
+ * @param curve Compiled curve
+ * @param arcTable Arc-length table of the curve
+ * @param rmfTable Rotation-minimizing frames (TRACK_FRAME_RMF only), or NULL to
+ *                 carry them from sample to sample at the track's own spacing
+ * @param frame Orientation mode
+ * @param speed Units per second (> 0)
+ * @param timestep Seconds between samples (> 0)
+ * @return Newly allocated track (free with track_free), or NULL on error
+ */
+Track* track_bake(const BSplineCurve* curve, const ArcLengthTable* arcTable,
+                  const RMFTable* rmfTable, TrackFrame frame, double speed, double timestep);
+
+// ============================================================================
+// FILES
+// ============================================================================
+
+/**
+ * Write track file
+ *
+ * @param track Track to write
+ * @param filename Output file
+ * @return 1 on success, 0 on error
+ */
+int track_write(const Track* track, const char* filename);
+
+/**
+ * Map a track file (read-only, nothing is copied)
+ *
+ * @param filename Track file
+ * @return Newly allocated track (free with track_free), or NULL on error
+ */
+Track* track_open(const char* filename);
+
+/**
+ * Check for the track file magic
+ *
+ * @param filename File to check
+ * @return 1 if the file starts with TRACKFILE_MAGIC, 0 otherwise
+ */
+int track_isTrackFile(const char* filename);
+
+/**
+ * Free track (unmaps file-backed tracks)
+ *
+ * @param track Track to free (NULL is allowed)
+ */
+void track_free(Track* track);
+
+// ============================================================================
+// PLAYBACK
+// ============================================================================
+
+/**
+ * Sample track at any time (random seek, O(1))
+ *
+ * @param track Track
+ * @param time Seconds from the start
+ * @param loop 1 wraps time into [0, duration), 0 clamps it
+ * @return Interpolated sample (lerp position, nlerp rotation)
+ */
+TrackSample track_sample(const Track* track, double time, int loop);
+
+/**
+ * Sample track for many agents: out[i] = track_sample(track, times[i], loop)
+ *
+ * Rotations are blended in blocks with quat_nlerpBatch.
+ *
+ * @param track Track
+ * @param times Seconds from the start, one per agent
+ * @param count Number of agents
+ * @param loop 1 wraps time, 0 clamps it
+ * @param out Output samples
+ */
+void track_sampleBatch(const Track* track, const double* times, int count, int loop,
+                       TrackSample* out);
+
+#endif // TRACK_FILE_H
@@ -0,0 +1,404 @@
+#include "vec3_batch.h"
+#include "simd_dispatch.h"
+#include <float.h>
+#include <math.h>
+#include <pthread.h>
+
+typedef struct {
+    void (*cross)(const Vec3* a, const Vec3* b, Vec3* out, int begin, int count);
+    void (*dot)(const Vec3* a, const Vec3* b, double* out, int begin, int count);
+    void (*normalize)(const Vec3* in, Vec3* out, int begin, int count);
+    void (*normalizeFast)(const Vec3* in, Vec3* out, int begin, int count);
+    void (*rsqrt)(const float* in, float* out, int begin, int count);
+} Vec3Kernels;
+
+// ============================================================================
+// SCALAR KERNELS
+// Also finish the tails the vector kernels leave over ([begin, count)).
+// ============================================================================
+
+static void cross_scalar(const Vec3* a, const Vec3* b, Vec3* out, int begin, int count) {
+    for (int i = begin; i < count; i++) {
+        out[i] = bspline_cross(a[i], b[i]);
+    }
+}
+
+static void dot_scalar(const Vec3* a, const Vec3* b, double* out, int begin, int count) {
+    for (int i = begin; i < count; i++) {
+        out[i] = bspline_dot(a[i], b[i]);
+    }
+}
+
+static void normalize_scalar(const Vec3* in, Vec3* out, int begin, int count) {
+    for (int i = begin; i < count; i++) {
+        out[i] = bspline_normalize(in[i]);
+    }
+}
+
+static void normalizeFast_scalar(const Vec3* in, Vec3* out, int begin, int count) {
+    for (int i = begin; i < count; i++) {
+        Vec3 v = in[i];
+        double len2 = v.x * v.x + v.y * v.y + v.z * v.z;
+        if (!(len2 >= 1e-18 && len2 <= FLT_MAX)) {
+            out[i] = (Vec3){0.0, 0.0, 0.0};
+            continue;
+        }
+        double inv = 1.0 / sqrt(len2);
+        out[i] = (Vec3){v.x * inv, v.y * inv, v.z * inv};
+    }
+}
+
+static void rsqrt_scalar(const float* in, float* out, int begin, int count) {
+    for (int i = begin; i < count; i++) {
+        out[i] = 1.0f / sqrtf(in[i]);
+    }
+}
+
+static const Vec3Kernels scalarKernels = {
+    cross_scalar, dot_scalar, normalize_scalar, normalizeFast_scalar, rsqrt_scalar
+};
+
+#if defined(SIMD_X86)
+
+// ============================================================================
+// SSE2 KERNELS (2 vectors per step)
+// Two Vec3 are six doubles; three unaligned loads give (x0 y0) (z0 x1)
+// (y1 z1), which shuffle into one register per component.
+// ============================================================================
+
+static inline SIMD_TARGET("sse2")
+void load2(const Vec3* v, __m128d* x, __m128d* y, __m128d* z) {
+    const double* p = &v->x;
+    __m128d xy0 = _mm_loadu_pd(p);
+    __m128d z0x1 = _mm_loadu_pd(p + 2);
+    __m128d y1z1 = _mm_loadu_pd(p + 4);
+    *x = _mm_shuffle_pd(xy0, z0x1, 2);   // (x0, x1)
+    *y = _mm_shuffle_pd(xy0, y1z1, 1);   // (y0, y1)
+    *z = _mm_shuffle_pd(z0x1, y1z1, 2);  // (z0, z1)
+}
+
+static inline SIMD_TARGET("sse2")
+void store2(Vec3* v, __m128d x, __m128d y, __m128d z) {
+    double* p = &v->x;
+    _mm_storeu_pd(p, _mm_unpacklo_pd(x, y));
+    _mm_storeu_pd(p + 2, _mm_shuffle_pd(z, x, 2));
+    _mm_storeu_pd(p + 4, _mm_unpackhi_pd(y, z));
+}
+
+static SIMD_TARGET("sse2")
+void cross_sse2(const Vec3* a, const Vec3* b, Vec3* out, int begin, int count) {
+    int i = begin;
+    for (; i + 2 <= count; i += 2) {
+        __m128d ax, ay, az, bx, by, bz;
+        load2(a + i, &ax, &ay, &az);
+        load2(b + i, &bx, &by, &bz);
+        store2(out + i,
+               _mm_sub_pd(_mm_mul_pd(ay, bz), _mm_mul_pd(az, by)),
+               _mm_sub_pd(_mm_mul_pd(az, bx), _mm_mul_pd(ax, bz)),
+               _mm_sub_pd(_mm_mul_pd(ax, by), _mm_mul_pd(ay, bx)));
+    }
+    cross_scalar(a, b, out, i, count);
+}
+
+static SIMD_TARGET("sse2")
+void dot_sse2(const Vec3* a, const Vec3* b, double* out, int begin, int count) {
+    int i = begin;
+    for (; i + 2 <= count; i += 2) {
+        __m128d ax, ay, az, bx, by, bz;
+        load2(a + i, &ax, &ay, &az);
+        load2(b + i, &bx, &by, &bz);
+        __m128d sum = _mm_add_pd(_mm_mul_pd(ax, bx), _mm_mul_pd(ay, by));
+        _mm_storeu_pd(out + i, _mm_add_pd(sum, _mm_mul_pd(az, bz)));
+    }
+    dot_scalar(a, b, out, i, count);
+}
+
+static SIMD_TARGET("sse2")
+void normalize_sse2(const Vec3* in, Vec3* out, int begin, int count) {
+    const __m128d eps = _mm_set1_pd(1e-9);
+    int i = begin;
+    for (; i + 2 <= count; i += 2) {
+        __m128d x, y, z;
+        load2(in + i, &x, &y, &z);
+        __m128d len2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)), _mm_mul_pd(z, z));
+        __m128d len = _mm_sqrt_pd(len2);
+        __m128d keep = _mm_cmpnlt_pd(len, eps);  // !(len < 1e-9), as bspline_normalize
+        store2(out + i,
+               _mm_and_pd(_mm_div_pd(x, len), keep),
+               _mm_and_pd(_mm_div_pd(y, len), keep),
+               _mm_and_pd(_mm_div_pd(z, len), keep));
+    }
+    normalize_scalar(in, out, i, count);
+}
+
+static SIMD_TARGET("sse2")
+void normalizeFast_sse2(const Vec3* in, Vec3* out, int begin, int count) {
+    const __m128d lo = _mm_set1_pd(1e-18), hi = _mm_set1_pd(FLT_MAX);
+    const __m128d half = _mm_set1_pd(0.5), threeHalves = _mm_set1_pd(1.5);
+    int i = begin;
+    for (; i + 2 <= count; i += 2) {
+        __m128d x, y, z;
+        load2(in + i, &x, &y, &z);
+        __m128d len2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)), _mm_mul_pd(z, z));
+        __m128d keep = _mm_and_pd(_mm_cmpge_pd(len2, lo), _mm_cmple_pd(len2, hi));
+
+        // 12-bit estimate in float, one Newton step in double
+        __m128d inv = _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(len2)));
+        __m128d inv2 = _mm_mul_pd(inv, inv);
+        inv = _mm_mul_pd(inv, _mm_sub_pd(threeHalves, _mm_mul_pd(_mm_mul_pd(half, len2), inv2)));
+        inv = _mm_and_pd(inv, keep);
+
+        store2(out + i, _mm_mul_pd(x, inv), _mm_mul_pd(y, inv), _mm_mul_pd(z, inv));
+    }
+    normalizeFast_scalar(in, out, i, count);
+}
+
+static SIMD_TARGET("sse2")
+void rsqrt_sse2(const float* in, float* out, int begin, int count) {
+    const __m128 half = _mm_set1_ps(0.5f), threeHalves = _mm_set1_ps(1.5f);
+    int i = begin;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(in + i);
+        __m128 y = _mm_rsqrt_ps(x);
+        __m128 y2 = _mm_mul_ps(y, y);
+        y = _mm_mul_ps(y, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, x), y2)));
+        _mm_storeu_ps(out + i, y);
+    }
+    rsqrt_scalar(in, out, i, count);
+}
+
+static const Vec3Kernels sse2Kernels = {
+    cross_sse2, dot_sse2, normalize_sse2, normalizeFast_sse2, rsqrt_sse2
+};
+
+// ============================================================================
+// AVX KERNELS (4 vectors per step)
+// Same shuffle as SSE2, once per 128-bit half: the halves hold vectors
+// (0, 1) and (2, 3).
+// ============================================================================
+
+static inline SIMD_TARGET("avx")
+__m256d loadHalves(const double* p) {
+    return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(p)), _mm_loadu_pd(p + 6), 1);
+}
+
+static inline SIMD_TARGET("avx")
+void storeHalves(double* p, __m256d v) {
+    _mm_storeu_pd(p, _mm256_castpd256_pd128(v));
+    _mm_storeu_pd(p + 6, _mm256_extractf128_pd(v, 1));
+}
+
+static inline SIMD_TARGET("avx")
+void load4(const Vec3* v, __m256d* x, __m256d* y, __m256d* z) {
+    const double* p = &v->x;
+    __m256d xy = loadHalves(p);      // (x0 y0 | x2 y2)
+    __m256d zx = loadHalves(p + 2);  // (z0 x1 | z2 x3)
+    __m256d yz = loadHalves(p + 4);  // (y1 z1 | y3 z3)
+    *x = _mm256_shuffle_pd(xy, zx, 0xA);
+    *y = _mm256_shuffle_pd(xy, yz, 0x5);
+    *z = _mm256_shuffle_pd(zx, yz, 0xA);
+}
+
+static inline SIMD_TARGET("avx")
+void store4(Vec3* v, __m256d x, __m256d y, __m256d z) {
+    double* p = &v->x;
+    storeHalves(p, _mm256_unpacklo_pd(x, y));
+    storeHalves(p + 2, _mm256_shuffle_pd(z, x, 0xA));
+    storeHalves(p + 4, _mm256_unpackhi_pd(y, z));
+}
+
+static SIMD_TARGET("avx")
+void cross_avx(const Vec3* a, const Vec3* b, Vec3* out, int begin, int count) {
+    int i = begin;
+    for (; i + 4 <= count; i += 4) {
+        __m256d ax, ay, az, bx, by, bz;
+        load4(a + i, &ax, &ay, &az);
+        load4(b + i, &bx, &by, &bz);
+        store4(out + i,
+               _mm256_sub_pd(_mm256_mul_pd(ay, bz), _mm256_mul_pd(az, by)),
+               _mm256_sub_pd(_mm256_mul_pd(az, bx), _mm256_mul_pd(ax, bz)),
+               _mm256_sub_pd(_mm256_mul_pd(ax, by), _mm256_mul_pd(ay, bx)));
+    }
+    cross_sse2(a, b, out, i, count);
+}
+
+static SIMD_TARGET("avx")
+void dot_avx(const Vec3* a, const Vec3* b, double* out, int begin, int count) {
+    int i = begin;
+    for (; i + 4 <= count; i += 4) {
+        __m256d ax, ay, az, bx, by, bz;
+        load4(a + i, &ax, &ay, &az);
+        load4(b + i, &bx, &by, &bz);
+        __m256d sum = _mm256_add_pd(_mm256_mul_pd(ax, bx), _mm256_mul_pd(ay, by));
+        _mm256_storeu_pd(out + i, _mm256_add_pd(sum, _mm256_mul_pd(az, bz)));
+    }
+    dot_sse2(a, b, out, i, count);
+}
+
+static SIMD_TARGET("avx")
+void normalize_avx(const Vec3* in, Vec3* out, int begin, int count) {
+    const __m256d eps = _mm256_set1_pd(1e-9);
+    int i = begin;
+    for (; i + 4 <= count; i += 4) {
+        __m256d x, y, z;
+        load4(in + i, &x, &y, &z);
+        __m256d len2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)),
+                                     _mm256_mul_pd(z, z));
+        __m256d len = _mm256_sqrt_pd(len2);
+        __m256d keep = _mm256_cmp_pd(len, eps, _CMP_NLT_UQ);
+        store4(out + i,
+               _mm256_and_pd(_mm256_div_pd(x, len), keep),
+               _mm256_and_pd(_mm256_div_pd(y, len), keep),
+               _mm256_and_pd(_mm256_div_pd(z, len), keep));
+    }
+    normalize_sse2(in, out, i, count);
+}
+
+static SIMD_TARGET("avx")
+void normalizeFast_avx(const Vec3* in, Vec3* out, int begin, int count) {
+    const __m256d lo = _mm256_set1_pd(1e-18), hi = _mm256_set1_pd(FLT_MAX);
+    const __m256d half = _mm256_set1_pd(0.5), threeHalves = _mm256_set1_pd(1.5);
+    int i = begin;
+    for (; i + 4 <= count; i += 4) {
+        __m256d x, y, z;
+        load4(in + i, &x, &y, &z);
+        __m256d len2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)),
+                                     _mm256_mul_pd(z, z));
+        __m256d keep = _mm256_and_pd(_mm256_cmp_pd(len2, lo, _CMP_GE_OQ),
+                                     _mm256_cmp_pd(len2, hi, _CMP_LE_OQ));
+
+        __m256d inv = _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(len2)));
+        __m256d inv2 = _mm256_mul_pd(inv, inv);
+        inv = _mm256_mul_pd(inv, _mm256_sub_pd(threeHalves,
+                                               _mm256_mul_pd(_mm256_mul_pd(half, len2), inv2)));
+        inv = _mm256_and_pd(inv, keep);
+
+        store4(out + i, _mm256_mul_pd(x, inv), _mm256_mul_pd(y, inv), _mm256_mul_pd(z, inv));
+    }
+    normalizeFast_sse2(in, out, i, count);
+}
+
+static SIMD_TARGET("avx")
+void rsqrt_avx(const float* in, float* out, int begin, int count) {
+    const __m256 half = _mm256_set1_ps(0.5f), threeHalves = _mm256_set1_ps(1.5f);
+    int i = begin;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(in + i);
+        __m256 y = _mm256_rsqrt_ps(x);
+        __m256 y2 = _mm256_mul_ps(y, y);
+        y = _mm256_mul_ps(y, _mm256_sub_ps(threeHalves, _mm256_mul_ps(_mm256_mul_ps(half, x), y2)));
+        _mm256_storeu_ps(out + i, y);
+    }
+    rsqrt_sse2(in, out, i, count);
+}
+
+static const Vec3Kernels avxKernels = {
+    cross_avx, dot_avx, normalize_avx, normalizeFast_avx, rsqrt_avx
+};
+
+#endif
+
+// ============================================================================
+// DISPATCH
+// ============================================================================
+
+static pthread_once_t dispatchOnce = PTHREAD_ONCE_INIT;
+static const Vec3Kernels* currentKernels = &scalarKernels;
+static Vec3Kernel currentKernel = VEC3_KERNEL_SCALAR;
+
+static int kernelSupported(Vec3Kernel kernel) {
+    switch (kernel) {
+        case VEC3_KERNEL_SCALAR:
+            return 1;
+#if defined(SIMD_X86)
+        case VEC3_KERNEL_SSE2:
+            return simd_cpuLevel() >= SIMD_LEVEL_SSE2;
+        case VEC3_KERNEL_AVX:
+            return simd_cpuLevel() >= SIMD_LEVEL_AVX;
+#endif
+        default:
+            return 0;
+    }
+}
+
+static void selectKernel(Vec3Kernel kernel) {
+#if defined(SIMD_X86)
+    if (kernel == VEC3_KERNEL_AVX) {
+        currentKernels = &avxKernels;
+    } else if (kernel == VEC3_KERNEL_SSE2) {
+        currentKernels = &sse2Kernels;
+    } else {
+        currentKernels = &scalarKernels;
+    }
+#else
+    currentKernels = &scalarKernels;
+#endif
+    currentKernel = kernel;
+}
+
+static Vec3Kernel bestKernel(void) {
+    if (kernelSupported(VEC3_KERNEL_AVX)) return VEC3_KERNEL_AVX;
+    if (kernelSupported(VEC3_KERNEL_SSE2)) return VEC3_KERNEL_SSE2;
+    return VEC3_KERNEL_SCALAR;
+}
+
+static void initDispatch(void) {
+    selectKernel(bestKernel());
+}
+
+static const Vec3Kernels* kernels(void) {
+    pthread_once(&dispatchOnce, initDispatch);
+    return currentKernels;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+Vec3Kernel vec3_activeKernel(void) {
+    kernels();
+    return currentKernel;
+}
+
+int vec3_setKernel(Vec3Kernel kernel) {
+    kernels();
+    if (kernel == VEC3_KERNEL_AUTO) kernel = bestKernel();
+    if (!kernelSupported(kernel)) return 0;
+    selectKernel(kernel);
+    return 1;
+}
+
+const char* vec3_kernelName(Vec3Kernel kernel) {
+    switch (kernel) {
+        case VEC3_KERNEL_AUTO:   return "auto";
+        case VEC3_KERNEL_SCALAR: return "scalar";
+        case VEC3_KERNEL_SSE2:   return "sse2";
+        case VEC3_KERNEL_AVX:    return "avx";
+    }
+    return "unknown";
+}
+
+void vec3_crossArray(const Vec3* a, const Vec3* b, Vec3* out, int count) {
+    if (!a || !b || !out || count <= 0) return;
+    kernels()->cross(a, b, out, 0, count);
+}
+
+void vec3_dotArray(const Vec3* a, const Vec3* b, double* out, int count) {
+    if (!a || !b || !out || count <= 0) return;
+    kernels()->dot(a, b, out, 0, count);
+}
+
+void vec3_normalizeArray(const Vec3* in, Vec3* out, int count) {
+    if (!in || !out || count <= 0) return;
+    kernels()->normalize(in, out, 0, count);
+}
+
+void vec3_normalizeArrayFast(const Vec3* in, Vec3* out, int count) {
+    if (!in || !out || count <= 0) return;
+    kernels()->normalizeFast(in, out, 0, count);
+}
+
+void vec3_rsqrtArray(const float* in, float* out, int count) {
+    if (!in || !out || count <= 0) return;
+    kernels()->rsqrt(in, out, 0, count);
+}
@@ -0,0 +1,113 @@
+#ifndef VEC3_BATCH_H
+#define VEC3_BATCH_H
+
+#include "bspline.h"
+
+// ============================================================================
+// BATCHED VEC3 MATH
+// Array counterparts of bspline_cross / bspline_dot / bspline_normalize for
+// bulk work (curve tables, mesh normals). Kernels: AVX, SSE2 or scalar,
+// picked at run time from the CPU's features on x86; other targets use the
+// scalar kernel. The exact kernels give bit-identical results to the scalar
+// helpers, so switching kernels never changes baked data.
+// ============================================================================
+
+/**
+ * Kernel families
+ */
+typedef enum {
+    VEC3_KERNEL_AUTO = 0,   // Best kernel the CPU supports
+    VEC3_KERNEL_SCALAR,
+    VEC3_KERNEL_SSE2,
+    VEC3_KERNEL_AVX
+} Vec3Kernel;
+
+/**
+ * Kernel used by the array functions
+ *
+ * Resolved on first use from the CPU features (never VEC3_KERNEL_AUTO).
+ *
+ * @return Active kernel
+ */
+Vec3Kernel vec3_activeKernel(void);
+
+/**
+ * Force a kernel (benchmarks and cross-checks)
+ *
+ * Not synchronized with concurrent calls of the array functions.
+ *
+ * @param kernel Kernel to use, or VEC3_KERNEL_AUTO for the best available
+ * @return 1 if the kernel is now active, 0 if the CPU does not support it
+ */
+int vec3_setKernel(Vec3Kernel kernel);
+
+/**
+ * Printable kernel name ("scalar", "sse2", "avx")
+ *
+ * @param kernel Kernel
+ * @return Static string
+ */
+const char* vec3_kernelName(Vec3Kernel kernel);
+
+// ============================================================================
+// ARRAY OPERATIONS
+// Inputs and outputs may alias element for element (out == a is fine).
+// ============================================================================
+
+/**
+ * out[i] = a[i] × b[i]
+ *
+ * @param a First vectors
+ * @param b Second vectors
+ * @param out Output vectors
+ * @param count Number of vectors
+ */
+void vec3_crossArray(const Vec3* a, const Vec3* b, Vec3* out, int count);
+
+/**
+ * out[i] = a[i] · b[i]
+ *
+ * @param a First vectors
+ * @param b Second vectors
+ * @param out Output dot products
+ * @param count Number of vectors
+ */
+void vec3_dotArray(const Vec3* a, const Vec3* b, double* out, int count);
+
+/**
+ * out[i] = in[i] / |in[i]| (zero vector if |in[i]| < 1e-9)
+ *
+ * Same result as bspline_normalize for every element.
+ *
+ * @param in Input vectors
+ * @param out Output unit vectors
+ * @param count Number of vectors
+ */
+void vec3_normalizeArray(const Vec3* in, Vec3* out, int count);
+
+/**
+ * Approximate normalize using the reciprocal square root estimate
+ *
+ * Single precision accuracy (error ~2e-7 after one Newton step),
+ * which is all a glNormal3f needs. Vectors shorter than 1e-9, or with a
+ * squared length outside float range, become the zero vector.
+ *
+ * @param in Input vectors
+ * @param out Output unit vectors
+ * @param count Number of vectors
+ */
+void vec3_normalizeArrayFast(const Vec3* in, Vec3* out, int count);
+
+/**
+ * out[i] ≈ 1 / sqrt(in[i])
+ *
+ * Hardware estimate (SSE2/AVX kernels) refined with one Newton-Raphson step:
+ *   y' = y (1.5 - 0.5 x y^2)
+ *
+ * @param in Input values (> 0)
+ * @param out Output reciprocal square roots
+ * @param count Number of values
+ */
+void vec3_rsqrtArray(const float* in, float* out, int count);
+
+#endif // VEC3_BATCH_H
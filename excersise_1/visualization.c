@@ -1,4 +1,6 @@
 #include "visualization.h"
+#include "bspline_batch.h"
+#include "frustum.h"
 #include <stddef.h>  // For NULL
 
 #ifdef __APPLE__
@@ -11,6 +13,45 @@
 // VISUALIZATION HELPER FUNCTIONS
 // ============================================================================
 
+// Samples per segment for curve drawing (t = 0, 0.02, ..., 1.0)
+#define CURVE_SAMPLES_PER_SEGMENT 51
+
+// Tangents evaluated per batch when drawing along one segment
+#define MAX_TANGENT_SAMPLES 256
+
+/**
+ * Frustum of the current GL projection and modelview matrices
+ */
+static Frustum currentFrustum(void) {
+    GLdouble projection[16], modelview[16];
+    glGetDoublev(GL_PROJECTION_MATRIX, projection);
+    glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
+    return frustum_fromMatrices(projection, modelview);
+}
+
+/**
+ * Draw bound line strip, one glDrawArrays per run of visible segments
+ *
+ * Segment i starts at vertex segmentFirst[i - 1] (or (i - 1) * stride when
+ * segmentFirst is NULL) and ends where segment i + 1 starts.
+ */
+static void drawVisibleRuns(const AABB* bounds, int numSegments, int stride, const int* segmentFirst) {
+    Frustum frustum = currentFrustum();
+    int runStart = -1;
+    
+    for (int seg = 1; seg <= numSegments + 1; seg++) {
+        int visible = (seg <= numSegments) && frustum_intersectsBox(&frustum, &bounds[seg - 1]);
+        if (visible && runStart < 0) {
+            runStart = seg;
+        } else if (!visible && runStart >= 0) {
+            int first = segmentFirst ? segmentFirst[runStart - 1] : (runStart - 1) * stride;
+            int last = segmentFirst ? segmentFirst[seg - 1] : (seg - 1) * stride;
+            glDrawArrays(GL_LINE_STRIP, first, last - first + 1);
+            runStart = -1;
+        }
+    }
+}
+
 void drawBSplineCurve(const Vec3* controlPoints, int numSegments, const float* color) {
     if (!controlPoints || numSegments <= 0) return;
     
@@ -23,17 +64,77 @@ void drawBSplineCurve(const Vec3* controlPoints, int numSegments, const float* c
     
     glLineWidth(2.0f);
     
-    // Draw each segment
+    // Same parameters for every segment - compute once
+    float ts[CURVE_SAMPLES_PER_SEGMENT];
+    float xs[CURVE_SAMPLES_PER_SEGMENT], ys[CURVE_SAMPLES_PER_SEGMENT], zs[CURVE_SAMPLES_PER_SEGMENT];
+    bspline_uniformParameters(ts, CURVE_SAMPLES_PER_SEGMENT);
+    
+    Frustum frustum = currentFrustum();
+    
+    // Draw each segment (off-screen ones are skipped before evaluation)
     for (int seg = 1; seg <= numSegments; seg++) {
+        AABB box = bspline_segmentBounds(controlPoints, seg);
+        if (!frustum_intersectsBox(&frustum, &box)) continue;
+        
+        bspline_evaluatePositionBatch(controlPoints, seg, ts, CURVE_SAMPLES_PER_SEGMENT, xs, ys, zs);
+        
         glBegin(GL_LINE_STRIP);
-        for (float t = 0.0f; t <= 1.0f; t += 0.02f) {
-            Vec3 p = bspline_evaluatePosition(controlPoints, seg, t);
-            glVertex3f(p.x, p.y, p.z);
+        for (int i = 0; i < CURVE_SAMPLES_PER_SEGMENT; i++) {
+            glVertex3f(xs[i], ys[i], zs[i]);
         }
         glEnd();
     }
 }
 
+void drawCurveTessellation(const BSplineTessellation* tess, const AABB* bounds, const float* color) {
+    if (!tess || !tess->vertices || tess->numVertices < 2) return;
+    
+    // Default color: gray
+    if (color) {
+        glColor3fv(color);
+    } else {
+        glColor3f(0.5f, 0.5f, 0.5f);
+    }
+    
+    glLineWidth(2.0f);
+    
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, tess->vertices);
+    
+    int stride = tess->samplesPerSegment - 1;
+    if (bounds) {
+        drawVisibleRuns(bounds, (tess->numVertices - 1) / stride, stride, NULL);
+    } else {
+        glDrawArrays(GL_LINE_STRIP, 0, tess->numVertices);
+    }
+    
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void drawAdaptiveTessellation(const AdaptiveTessellation* tess, const AABB* bounds, const float* color) {
+    if (!tess || !tess->valid || tess->numVertices < 2) return;
+    
+    // Default color: gray
+    if (color) {
+        glColor3fv(color);
+    } else {
+        glColor3f(0.5f, 0.5f, 0.5f);
+    }
+    
+    glLineWidth(2.0f);
+    
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, tess->vertices);
+    
+    if (bounds) {
+        drawVisibleRuns(bounds, tess->numSegments, 0, tess->segmentFirst);
+    } else {
+        glDrawArrays(GL_LINE_STRIP, 0, tess->numVertices);
+    }
+    
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
 void drawControlPoints(const Vec3* controlPoints, int numPoints, float size, const float* color) {
     if (!controlPoints || numPoints <= 0) return;
     
@@ -107,11 +208,27 @@ void drawTangentVector(Vec3 position, Vec3 tangent, float scale, const float* co
 void drawTangentsAlongSegment(const Vec3* controlPoints, int segment, int numSamples, float scale) {
     if (!controlPoints || numSamples <= 0) return;
     
-    for (int i = 0; i <= numSamples; i++) {
-        float t = (float)i / (float)numSamples;
-        Vec3 pos = bspline_evaluatePosition(controlPoints, segment, t);
-        Vec3 tan = bspline_evaluateTangent(controlPoints, segment, t);
-        drawTangentVector(pos, tan, scale, NULL);  // Default yellow
+    // numSamples intervals -> numSamples + 1 tangents (both segment ends included),
+    // evaluated in batches of at most MAX_TANGENT_SAMPLES
+    int total = numSamples + 1;
+    float ts[MAX_TANGENT_SAMPLES];
+    float px[MAX_TANGENT_SAMPLES], py[MAX_TANGENT_SAMPLES], pz[MAX_TANGENT_SAMPLES];
+    float tx[MAX_TANGENT_SAMPLES], ty[MAX_TANGENT_SAMPLES], tz[MAX_TANGENT_SAMPLES];
+    
+    for (int first = 0; first < total; first += MAX_TANGENT_SAMPLES) {
+        int count = (total - first < MAX_TANGENT_SAMPLES) ? total - first : MAX_TANGENT_SAMPLES;
+        for (int i = 0; i < count; i++) {
+            ts[i] = (float)(first + i) / (float)numSamples;
+        }
+        
+        bspline_evaluatePositionBatch(controlPoints, segment, ts, count, px, py, pz);
+        bspline_evaluateTangentBatch(controlPoints, segment, ts, count, tx, ty, tz);
+        
+        for (int i = 0; i < count; i++) {
+            Vec3 pos = {px[i], py[i], pz[i]};
+            Vec3 tan = {tx[i], ty[i], tz[i]};
+            drawTangentVector(pos, tan, scale, NULL);  // Default yellow
+        }
     }
 }
 
@@ -2,6 +2,9 @@
 #define VISUALIZATION_H
 
 #include "bspline.h"
+#include "bspline_tessellate.h"
+#include "bspline_bounds.h"
+#include "bspline_adaptive.h"
 
 // ============================================================================
 // VISUALIZATION HELPER FUNCTIONS
@@ -11,7 +14,9 @@
 /**
  * Draw B-spline curve
  * 
- * Draws the entire curve by sampling each segment.
+ * Draws the entire curve by sampling each segment. Segments whose
+ * control hull lies outside the current view frustum are skipped
+ * before any evaluation.
  * 
  * @param controlPoints Array of control points
  * @param numSegments Number of segments (n-3)
@@ -19,6 +24,31 @@
  */
 void drawBSplineCurve(const Vec3* controlPoints, int numSegments, const float* color);
 
+/**
+ * Draw pre-tessellated B-spline curve
+ * 
+ * Submits the line strip with glDrawArrays (no curve evaluation at draw
+ * time). With per-segment bounds, segments outside the current view
+ * frustum are culled and each visible run is one draw call.
+ * 
+ * @param tess Tessellation built with bspline_buildTessellation
+ * @param bounds Per-segment bounds (index 0 = segment 1), or NULL to draw everything
+ * @param color RGB color (NULL for default gray)
+ */
+void drawCurveTessellation(const BSplineTessellation* tess, const AABB* bounds, const float* color);
+
+/**
+ * Draw adaptively tessellated B-spline curve
+ * 
+ * Same as drawCurveTessellation for tessellations built with
+ * bspline_updateAdaptiveTessellation.
+ * 
+ * @param tess Adaptive tessellation
+ * @param bounds Per-segment bounds (index 0 = segment 1), or NULL to draw everything
+ * @param color RGB color (NULL for default gray)
+ */
+void drawAdaptiveTessellation(const AdaptiveTessellation* tess, const AABB* bounds, const float* color);
+
 /**
  * Draw control points as dots
  * 